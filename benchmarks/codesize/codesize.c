@@ -0,0 +1,178 @@
+/*
+ *  Source file of a benchmark program that has a large code footprint: it
+ *  calls thousands of distinct generated functions, in a round-robin, a
+ *  Zipfian or a uniformly random order. Under QEMU, the calls jump between
+ *  far more translated blocks than the jump cache of each CPU holds, and
+ *  when QEMU is run with a small translation buffer (-tb-size 1, as in the
+ *  nightly tests), the buffer is flushed and the code translated again over
+ *  and over. The functions are called n times in total. The number n can be
+ *  given via command line, and the default is 1000000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
+/* The generated functions, and the table "functions" of pointers to them */
+#include "codesize_functions.c.inc"
+
+/* Number of calls of the functions */
+#define NUMBER_OF_CALLS 1000000
+#define MAX_NUMBER_OF_CALLS 2000000000
+
+/*
+ * Length of the precalculated sequence of called functions, which is
+ * repeated for longer runs. It is a multiple of the number of functions, so
+ * the round-robin order is not broken when the sequence wraps around.
+ */
+#define SEQUENCE_LENGTH (16 * NUMBER_OF_FUNCTIONS)
+
+/**
+ * Fill the sequence with the functions in round-robin order.
+ * @param sequence Sequence of function indexes.
+ */
+static void fill_roundrobin(uint32_t *sequence)
+{
+    for (int i = 0; i < SEQUENCE_LENGTH; i++) {
+        sequence[i] = i % NUMBER_OF_FUNCTIONS;
+    }
+}
+
+/**
+ * Fill the sequence with functions drawn from a Zipfian distribution with
+ * exponent 1: the function of rank k is called with a probability
+ * proportional to 1/k. The functions are assigned their ranks in a random
+ * order, so the most frequently called functions are spread over the code.
+ * @param sequence Sequence of function indexes.
+ */
+static void fill_zipf(uint32_t *sequence)
+{
+    static double cumulative[NUMBER_OF_FUNCTIONS];
+    static uint32_t ranked[NUMBER_OF_FUNCTIONS];
+    double total = 0;
+
+    for (int k = 0; k < NUMBER_OF_FUNCTIONS; k++) {
+        total += 1.0 / (k + 1);
+        cumulative[k] = total;
+        ranked[k] = k;
+    }
+
+    /* Shuffle the ranks with the Fisher-Yates algorithm */
+    for (int k = NUMBER_OF_FUNCTIONS - 1; k > 0; k--) {
+        uint32_t j = random_below(k + 1);
+        uint32_t temp = ranked[k];
+
+        ranked[k] = ranked[j];
+        ranked[j] = temp;
+    }
+
+    /* Draw each function with a binary search in the cumulative weights */
+    for (int i = 0; i < SEQUENCE_LENGTH; i++) {
+        double weight = random_double() * total;
+        int low = 0;
+        int high = NUMBER_OF_FUNCTIONS - 1;
+
+        while (low < high) {
+            int middle = (low + high) / 2;
+
+            if (cumulative[middle] <= weight) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        sequence[i] = ranked[low];
+    }
+}
+
+/**
+ * Fill the sequence with functions drawn uniformly at random.
+ * @param sequence Sequence of function indexes.
+ */
+static void fill_random(uint32_t *sequence)
+{
+    for (int i = 0; i < SEQUENCE_LENGTH; i++) {
+        sequence[i] = random_below(NUMBER_OF_FUNCTIONS);
+    }
+}
+
+BENCHMARK_MAIN(codesize)
+{
+    static uint32_t sequence[SEQUENCE_LENGTH];
+    static uint8_t called[NUMBER_OF_FUNCTIONS];
+    int number_of_calls = NUMBER_OF_CALLS;
+    const char *pattern = "roundrobin";
+    int number_of_called_functions = 0;
+    uint32_t value = 0;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:p:")) != -1) {
+        if (option == 'n') {
+            number_of_calls = parse_int_option(option, optarg, 1,
+                                               MAX_NUMBER_OF_CALLS);
+        } else if (option == 'p') {
+            pattern = optarg;
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Seed random function with constant value, then fill the sequence */
+    random_seed(1);
+    if (strcmp(pattern, "roundrobin") == 0) {
+        fill_roundrobin(sequence);
+    } else if (strcmp(pattern, "zipf") == 0) {
+        fill_zipf(sequence);
+    } else if (strcmp(pattern, "random") == 0) {
+        fill_random(sequence);
+    } else {
+        fprintf(stderr, "Error ... Invalid value for option '-p'.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Call the functions in the order of the sequence, chaining the values */
+    roi_begin();
+    for (int i = 0; i < number_of_calls; i++) {
+        value = functions[sequence[i % SEQUENCE_LENGTH]](value + i);
+    }
+    roi_end();
+
+    /* Number of distinct functions called */
+    for (int i = 0; i < number_of_calls && i < SEQUENCE_LENGTH; i++) {
+        called[sequence[i]] = 1;
+    }
+    for (int k = 0; k < NUMBER_OF_FUNCTIONS; k++) {
+        number_of_called_functions += called[k];
+    }
+
+    /* Control printing */
+    printf("CONTROL RESULT:\n");
+    printf(" %u %d\n", value, number_of_called_functions);
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+
+"""
+Generate the functions of the codesize benchmark. Each function has its own
+random sequence of arithmetic statements, conditional branches, small loops
+and switch statements, so that no two functions share their machine code.
+The functions are written together with a table of pointers to them, to a
+file that is included by codesize.c.
+
+This file is a part of the project "TCG Continuous Benchmarking".
+
+Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/>.
+"""
+
+import argparse
+import os
+import random
+from typing import List
+
+# Default number of generated functions. They take about 650 KB of code on
+# x86_64, so their translated code (a few MB) needs a translation buffer
+# smaller than the default of QEMU (-tb-size 1) to be flushed and evicted.
+NUMBER_OF_FUNCTIONS = 4096
+
+# Range of the number of statements of a function
+MIN_STATEMENTS = 3
+MAX_STATEMENTS = 8
+
+# Number of function names per line of the table
+NAMES_PER_LINE = 4
+
+HEADER = """\
+/*
+ *  Functions of the codesize benchmark.
+ *
+ *  This file is generated by generate_functions.py with the options
+ *  '-f {functions} -s {seed}'. Do not edit it by hand.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define NUMBER_OF_FUNCTIONS {functions}
+"""
+
+
+def constant(generator: random.Random) -> str:
+    """
+    Generate a random 32-bit constant.
+
+    Parameters:
+    generator (random.Random): Random number generator
+
+    Returns:
+    (str): C literal of the constant
+    """
+    return "0x{:08x}u".format(generator.getrandbits(32))
+
+
+def generate_statement(generator: random.Random) -> List[str]:
+    """
+    Generate a random statement operating on the variable x.
+
+    Parameters:
+    generator (random.Random): Random number generator
+
+    Returns:
+    (List[str]): Lines of the statement, without indentation
+    """
+    kind = generator.randrange(7)
+    shift = generator.randint(1, 31)
+    if kind == 0:
+        return ["x = x * 0x{:08x}u + {};".format(
+            generator.getrandbits(32) | 1, constant(generator))]
+    if kind == 1:
+        return ["x ^= x >> {};".format(shift)]
+    if kind == 2:
+        return ["x = (x << {}) | (x >> {});".format(shift, 32 - shift)]
+    if kind == 3:
+        return ["if (x & {}) {{".format(constant(generator)),
+                "    x += {};".format(constant(generator)),
+                "} else {",
+                "    x ^= {};".format(constant(generator)),
+                "}"]
+    if kind == 4:
+        return ["if (x > {}) {{".format(constant(generator)),
+                "    x -= {};".format(constant(generator)),
+                "}"]
+    if kind == 5:
+        return ["for (int i = 0; i < {}; i++) {{".format(
+                    generator.randint(2, 5)),
+                "    x = x * 0x{:08x}u + i;".format(
+                    generator.getrandbits(32) | 1),
+                "}"]
+    return ["switch ((x >> {}) & 3) {{".format(generator.randint(0, 30)),
+            "case 0:",
+            "    x += {};".format(constant(generator)),
+            "    break;",
+            "case 1:",
+            "    x ^= {};".format(constant(generator)),
+            "    break;",
+            "case 2:",
+            "    x *= 0x{:08x}u;".format(generator.getrandbits(32) | 1),
+            "    break;",
+            "default:",
+            "    x -= {};".format(constant(generator)),
+            "    break;",
+            "}"]
+
+
+def generate_function(generator: random.Random, index: int) -> List[str]:
+    """
+    Generate a function with a random number of random statements.
+
+    Parameters:
+    generator (random.Random): Random number generator
+    index (int): Index of the function, used in its name
+
+    Returns:
+    (List[str]): Lines of the function
+    """
+    lines = ["static uint32_t function_{}(uint32_t x)".format(index), "{"]
+    for _ in range(generator.randint(MIN_STATEMENTS, MAX_STATEMENTS)):
+        lines.extend("    " + line for line in generate_statement(generator))
+    lines.extend(["    return x;", "}", ""])
+    return lines
+
+
+def main():
+    """
+    Parse the command line arguments, then generate the functions and write
+    them to the output file.
+    """
+    parser = argparse.ArgumentParser(
+        usage="generate_functions.py [-h] [-f FUNCTIONS] [-s SEED] [-o OUTPUT]")
+    parser.add_argument("-f", "--functions", dest="functions", type=int,
+                        default=NUMBER_OF_FUNCTIONS,
+                        help="Number of generated functions")
+    parser.add_argument("-s", "--seed", dest="seed", type=int, default=1,
+                        help="Seed of the random number generator")
+    parser.add_argument("-o", "--output", dest="output",
+                        default=os.path.join(
+                            os.path.dirname(os.path.abspath(__file__)),
+                            "codesize_functions.c.inc"),
+                        help="Output file")
+    args = parser.parse_args()
+    if args.functions < 1:
+        parser.error("the number of functions must be positive")
+
+    generator = random.Random(args.seed)
+    lines = HEADER.format(functions=args.functions,
+                          seed=args.seed).splitlines()
+    lines.append("")
+    for index in range(args.functions):
+        lines.extend(generate_function(generator, index))
+
+    # Table of pointers to all functions
+    lines.append("static uint32_t (*const functions[NUMBER_OF_FUNCTIONS])"
+                 "(uint32_t) = {")
+    for first in range(0, args.functions, NAMES_PER_LINE):
+        names = ["function_{},".format(index) for index in
+                 range(first, min(first + NAMES_PER_LINE, args.functions))]
+        lines.append("    " + " ".join(names))
+    lines.append("};")
+
+    with open(args.output, "w") as output_file:
+        output_file.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+/*
+ *  Entry point and command line parsing shared by the benchmarks.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Each benchmark defines its entry point with BENCHMARK_MAIN(name). When
+ * compiled on its own, this is the main() function of the program. When
+ * compiled with -DTCGBENCH, it is the function name_main(), which is called
+ * by the multi-call driver in tcgbench/tcgbench.c. The name is expanded
+ * before it is pasted, so it can also be given by a macro.
+ */
+#define BENCHMARK_ENTRY(NAME) NAME##_main
+
+#ifdef TCGBENCH
+#define BENCHMARK_MAIN(NAME) int BENCHMARK_ENTRY(NAME)(int argc, char *argv[])
+#else
+#define BENCHMARK_MAIN(NAME) int main(int argc, char *argv[])
+#endif
+
+/**
+ * Parse the value of an integer command line option. The program exits with
+ * an error message if the value is not a number or is out of range.
+ * @param option Option character.
+ * @param value Value of the option (optarg).
+ * @param min_value Smallest valid value (at least 1).
+ * @param max_value Largest valid value.
+ */
+static inline int parse_int_option(int option, const char *value,
+                                   int min_value, int max_value)
+{
+    int result = atoi(value);
+
+    /* Check if the value is a string or zero */
+    if (result == 0) {
+        fprintf(stderr, "Error ... Invalid value for option '-%c'.\n", option);
+        exit(EXIT_FAILURE);
+    }
+    /* Check if the value is a negative number or too small */
+    if (result < min_value) {
+        if (min_value == 1) {
+            fprintf(stderr, "Error ... Value for option '-%c' cannot be a "
+                            "negative number.\n", option);
+        } else {
+            fprintf(stderr, "Error ... Value for option '-%c' cannot be a "
+                            "number less than %d.\n", option, min_value);
+        }
+        exit(EXIT_FAILURE);
+    }
+    /* Check if the value is too large */
+    if (result > max_value) {
+        fprintf(stderr, "Error ... Value for option '-%c' cannot be "
+                        "more than %d.\n", option, max_value);
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+#endif
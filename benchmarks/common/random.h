@@ -0,0 +1,162 @@
+/*
+ *  Deterministic pseudo-random number generator shared by the benchmarks.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The benchmarks use the xoshiro256** generator (by David Blackman and
+ * Sebastiano Vigna) instead of rand(). Under qemu-user, rand() of the guest
+ * libc goes through the locking random_r(), which takes a large share of the
+ * executed instructions, and its sequence depends on the libc. xoshiro256**
+ * only uses 64-bit integer operations, so the inputs of the benchmarks are
+ * cheap to generate and bit-identical on all targets.
+ */
+static uint64_t random_state[4];
+
+/**
+ * Rotate a 64-bit value to the left.
+ * @param x Value to be rotated.
+ * @param k Number of bits (1 - 63).
+ */
+static inline uint64_t random_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Seed the generator. The state is filled with the outputs of the
+ * splitmix64 generator started from the seed, so any seed (including zero)
+ * gives a valid state.
+ * @param seed Seed of the generator.
+ */
+static inline void random_seed(uint64_t seed)
+{
+    for (size_t i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        random_state[i] = z ^ (z >> 31);
+    }
+}
+
+/**
+ * Return the next 64-bit random value.
+ */
+static inline uint64_t random_next(void)
+{
+    uint64_t result = random_rotl(random_state[1] * 5, 7) * 9;
+    uint64_t t = random_state[1] << 17;
+
+    random_state[2] ^= random_state[0];
+    random_state[3] ^= random_state[1];
+    random_state[1] ^= random_state[2];
+    random_state[0] ^= random_state[3];
+    random_state[2] ^= t;
+    random_state[3] = random_rotl(random_state[3], 45);
+
+    return result;
+}
+
+/**
+ * Scale a 32-bit random value to the range [0, bound) with a multiplication
+ * instead of a (slow and biased) remainder.
+ * @param x 32-bit random value.
+ * @param bound Upper bound (exclusive) of the result.
+ */
+static inline uint32_t random_scale(uint32_t x, uint32_t bound)
+{
+    return (uint32_t)(((uint64_t)x * bound) >> 32);
+}
+
+/**
+ * Return a random integer in the range [0, bound).
+ * @param bound Upper bound (exclusive) of the result.
+ */
+static inline uint32_t random_below(uint32_t bound)
+{
+    return random_scale(random_next() >> 32, bound);
+}
+
+/**
+ * Return a random double in the range [0, 1), using the upper 53 bits of
+ * the next random value.
+ */
+static inline double random_double(void)
+{
+    return (random_next() >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Fill an array with random integers in the range [0, bound).
+ * @param array Array to be filled.
+ * @param len Number of elements of the array.
+ * @param bound Upper bound (exclusive) of the elements.
+ */
+static inline void random_fill_int32(int32_t *array, size_t len,
+                                     uint32_t bound)
+{
+    for (size_t i = 0; i < len; i++) {
+        array[i] = random_below(bound);
+    }
+}
+
+/**
+ * Fill an array with random doubles in the range [0, scale).
+ * @param array Array to be filled.
+ * @param len Number of elements of the array.
+ * @param scale Upper bound (exclusive) of the elements.
+ */
+static inline void random_fill_double(double *array, size_t len, double scale)
+{
+    for (size_t i = 0; i < len; i++) {
+        array[i] = scale * random_double();
+    }
+}
+
+/**
+ * Fill an array with random small letters a-z. Two letters are taken from
+ * each 64-bit random value. No terminating null character is written.
+ * @param chars Array to be filled.
+ * @param len Number of letters.
+ */
+static inline void random_fill_letters(char *chars, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i + 1 < len; i += 2) {
+        uint64_t r = random_next();
+
+        chars[i] = 'a' + random_scale(r >> 32, 26);
+        chars[i + 1] = 'a' + random_scale((uint32_t)r, 26);
+    }
+    if (i < len) {
+        chars[i] = 'a' + random_below(26);
+    }
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ *  Region-of-interest markers shared by the benchmarks.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ROI_H
+#define ROI_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef ROI_CALLGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+/**
+ * The kernel of each benchmark is enclosed between roi_begin() and roi_end(),
+ * so the profilers can leave out the allocation and initialization of the
+ * inputs, and the printing of the control result.
+ *
+ * The benchmarks are run under QEMU, where the client requests of valgrind
+ * and the symbols of the guest are not visible to the profilers running on
+ * the host. The markers are therefore also signalled in ways that pass
+ * through QEMU:
+ *
+ * - roi_begin() and roi_end() call getpgid() and getsid(), which QEMU
+ *   forwards to the functions of the same name of the host libc. The
+ *   callgrind runs of the tools zero the counters before getpgid() and dump
+ *   them before getsid(), using the options '--zero-before' and
+ *   '--dump-before'. Neither call is made by QEMU itself.
+ *
+ * - If the environment variable ROI_PERF_CTL_FD holds the number of a file
+ *   descriptor, "enable" and "disable" are written to it, as expected by the
+ *   '--control' option of 'perf stat'. If ROI_PERF_ACK_FD is also set, the
+ *   acknowledgement of perf is awaited on it, so no kernel instruction is
+ *   executed before the counters are enabled.
+ *
+ * When a benchmark is compiled with -DROI_CALLGRIND and profiled natively
+ * with 'valgrind --tool=callgrind --instr-atstart=no', the markers also
+ * start and stop the instrumentation with the client requests of callgrind.
+ * Both functions are exported and never inlined, so they can also be used as
+ * probe points (for example, with 'perf probe -x'). They are weak symbols, so
+ * the copies of all benchmarks linked into tcgbench are merged into one.
+ */
+
+/**
+ * File descriptors used for the control of 'perf stat', -1 if unused, and -2
+ * if the environment has not been read yet.
+ */
+static int roi_perf_ctl_fd = -2;
+static int roi_perf_ack_fd = -1;
+
+/**
+ * Utility function for reading a file descriptor from the environment.
+ * @param name Name of the environment variable.
+ */
+static int roi_getenv_fd(const char *name)
+{
+    const char *value = getenv(name);
+
+    if (value == NULL || *value == '\0') {
+        return -1;
+    }
+    return atoi(value);
+}
+
+/**
+ * Send a command to 'perf stat' and wait for its acknowledgement, if the
+ * benchmark is run with the file descriptors of its '--control' option.
+ * @param command Command to be sent ("enable\n" or "disable\n").
+ */
+static void roi_perf_control(const char *command)
+{
+    char ack[16];
+
+    if (roi_perf_ctl_fd == -2) {
+        roi_perf_ctl_fd = roi_getenv_fd("ROI_PERF_CTL_FD");
+        roi_perf_ack_fd = roi_getenv_fd("ROI_PERF_ACK_FD");
+    }
+    if (roi_perf_ctl_fd < 0) {
+        return;
+    }
+    if (write(roi_perf_ctl_fd, command, strlen(command)) < 0) {
+        roi_perf_ctl_fd = -1;
+        return;
+    }
+    if (roi_perf_ack_fd >= 0 && read(roi_perf_ack_fd, ack, sizeof(ack)) < 0) {
+        roi_perf_ack_fd = -1;
+    }
+}
+
+/**
+ * Mark the beginning of the region of interest.
+ */
+__attribute__((noinline, used, weak)) void roi_begin(void)
+{
+    getpgid(0);
+    roi_perf_control("enable\n");
+#ifdef ROI_CALLGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+}
+
+/**
+ * Mark the end of the region of interest.
+ */
+__attribute__((noinline, used, weak)) void roi_end(void)
+{
+#ifdef ROI_CALLGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+    roi_perf_control("disable\n");
+    getsid(0);
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ *  Source file of a benchmark program that computes the net forces acting on
+ *  all n electrons randomly scattered across a 1m x 1m surface,
+ *  using double FP compiled with -ffast-math (which is required).
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The optimize pragma of GCC is not equivalent to -ffast-math (and is
+ * ignored by other compilers), so the file itself must be compiled with the
+ * flag. The nightly tests compile it separately for this reason.
+ */
+#ifndef __FAST_MATH__
+#error "coulomb_double_fastmath.c must be compiled with -ffast-math"
+#endif
+
+#include <stdint.h>
+#if defined(__SSE2_MATH__)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * Enable the flush of denormal results (and inputs) to zero, like the
+ * startup code (crtfastmath.o) that is linked into programs linked with
+ * -ffast-math. The multi-call driver is linked without the flag, because
+ * the mode would then apply to all benchmarks, so the benchmark sets it
+ * itself on the targets where the FP unit has it. On other targets only the
+ * code generation of -ffast-math is covered.
+ */
+static void enable_flush_to_zero(void)
+{
+#if defined(__SSE2_MATH__)
+    /* MXCSR: flush to zero (bit 15) and denormals are zero (bit 6) */
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+
+    /* FPCR: flush to zero (bit 24) */
+    __asm__ volatile("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ volatile("msr fpcr, %0" : : "r"(fpcr | (1 << 24)));
+#endif
+}
+
+#define FP_INIT() enable_flush_to_zero()
+
+#define FP_TYPE double
+#define FP_MATH(name) name
+#define FP_PRINT_TYPE double
+#define FP_PRINT_LENGTH "l"
+
+#define BENCHMARK_NAME coulomb_double_fastmath
+
+#include "coulomb.c.inc"
@@ -0,0 +1,48 @@
+/*
+ *  Source file of a benchmark program that computes the net forces acting on
+ *  all n electrons randomly scattered across a 1m x 1m surface,
+ *  using _Float128 FP.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Request the _Float128 versions of the math.h functions (cosf128...) */
+#define __STDC_WANT_IEC_60559_TYPES_EXT__
+#include <math.h>
+
+/*
+ * glibc declares the _Float128 math functions since version 2.26 on targets
+ * where the compiler supports the type. Elsewhere, the benchmark falls back
+ * to long double, which is still the widest FP type of the target.
+ */
+#if defined(__HAVE_FLOAT128) && __HAVE_FLOAT128
+#define FP_TYPE _Float128
+#define FP_MATH(name) name##f128
+#else
+#define FP_TYPE long double
+#define FP_MATH(name) name##l
+#endif
+
+/* printf has no conversion for _Float128, so it is printed as long double */
+#define FP_PRINT_TYPE long double
+#define FP_PRINT_LENGTH "L"
+
+#define BENCHMARK_NAME coulomb_float128
+
+#include "coulomb.c.inc"
@@ -32,13 +32,17 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
 /* Number of columns and rows in all matrixes*/
 #define DEFAULT_NODE_COUNT      2000
 #define MIN_NODE_COUNT          3
 #define MAX_NODE_COUNT          10000
 
 
-int32_t closest_index(int32_t count, double *distances, bool *flags)
+static int32_t closest_index(int32_t count, double *distances, bool *flags)
 {
     int32_t closest;
     double minimum = DBL_MAX;
@@ -63,8 +67,9 @@ int32_t closest_index(int32_t count, double *distances, bool *flags)
  * @param (in) source  Source node.
  * @param (in) matrix  Distance matrix.
  */
-void find_shortest_distances(double *distances, int32_t *via, double *eccent,
-                             int32_t count, int32_t source, double **matrix)
+static void find_shortest_distances(double *distances, int32_t *via,
+                                    double *eccent, int32_t count,
+                                    int32_t source, double **matrix)
 {
     bool *flags;
 
@@ -103,7 +108,7 @@ void find_shortest_distances(double *distances, int32_t *via, double *eccent,
 }
 
 
-int main(int argc, char *argv[])
+BENCHMARK_MAIN(dijkstra_double)
 {
     double **distance_matrix;
     double *shortest_distances;
@@ -111,32 +116,13 @@ int main(int argc, char *argv[])
     int32_t node_count = DEFAULT_NODE_COUNT;
     int32_t source_node = 0;
     double node_eccentricity = 0.0;
-    double range_factor = 999.0 / (double)(RAND_MAX);
     int32_t option;
 
     /* Parse command line options */
     while ((option = getopt(argc, argv, "n:")) != -1) {
         if (option == 'n') {
-            int32_t user_node_count = atoi(optarg);
-
-            /* Check if the value is a string or zero */
-            if (user_node_count == 0) {
-                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is a negative number */
-            if (user_node_count < MIN_NODE_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
-                                "number less than %d.\n", MIN_NODE_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is too large */
-            if (user_node_count > MAX_NODE_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be "
-                                "more than %d.\n", MAX_NODE_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            node_count = user_node_count;
+            node_count = parse_int_option(option, optarg, MIN_NODE_COUNT,
+                                          MAX_NODE_COUNT);
         } else {
             exit(EXIT_FAILURE);
         }
@@ -151,7 +137,7 @@ int main(int argc, char *argv[])
     via_node = (int32_t *)malloc(node_count * sizeof(int32_t));
 
     /* Initialize helper arrays and populate distance_matrix */
-    srand(1);
+    random_seed(1);
     for (size_t i = 0; i < node_count; i++) {
         shortest_distances[i] = 0.0;
         via_node[i] = -1;
@@ -159,13 +145,15 @@ int main(int argc, char *argv[])
     }
     for (size_t i = 0; i < node_count; i++) {
         for (size_t j = i + 1; j < node_count; j++) {
-            distance_matrix[i][j] = 1.0 + range_factor * (double)rand();
+            distance_matrix[i][j] = 1.0 + 999.0 * random_double();
             distance_matrix[j][i] = distance_matrix[i][j];
         }
     }
 
+    roi_begin();
     find_shortest_distances(shortest_distances, via_node, &node_eccentricity,
                             node_count, source_node, distance_matrix);
+    roi_end();
 
     /* Control printing */
     printf("CONTROL RESULT:\n");
@@ -191,4 +179,6 @@ int main(int argc, char *argv[])
     free(distance_matrix);
     free(shortest_distances);
     free(via_node);
+
+    return 0;
 }
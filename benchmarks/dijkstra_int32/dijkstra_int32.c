@@ -31,13 +31,17 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
 /* Number of columns and rows in all matrixes*/
 #define DEFAULT_NODE_COUNT      2000
 #define MIN_NODE_COUNT          3
 #define MAX_NODE_COUNT          10000
 
 
-int32_t closest_index(int32_t count, int32_t *distances, bool *flags)
+static int32_t closest_index(int32_t count, int32_t *distances, bool *flags)
 {
     int32_t closest;
     int32_t minimum = INT_MAX;
@@ -62,8 +66,9 @@ int32_t closest_index(int32_t count, int32_t *distances, bool *flags)
  * @param (in) source  Source node.
  * @param (in) matrix  Distance matrix.
  */
-void find_shortest_distances(int32_t *distances, int32_t *via, int32_t *eccent,
-                             int32_t count, int32_t source, int32_t **matrix)
+static void find_shortest_distances(int32_t *distances, int32_t *via,
+                                    int32_t *eccent, int32_t count,
+                                    int32_t source, int32_t **matrix)
 {
     bool *flags;
 
@@ -102,7 +107,7 @@ void find_shortest_distances(int32_t *distances, int32_t *via, int32_t *eccent,
 }
 
 
-int main(int argc, char *argv[])
+BENCHMARK_MAIN(dijkstra_int32)
 {
     int32_t **distance_matrix;
     int32_t *shortest_distances;
@@ -115,26 +120,8 @@ int main(int argc, char *argv[])
     /* Parse command line options */
     while ((option = getopt(argc, argv, "n:")) != -1) {
         if (option == 'n') {
-            int32_t user_node_count = atoi(optarg);
-
-            /* Check if the value is a string or zero */
-            if (user_node_count == 0) {
-                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is a negative number */
-            if (user_node_count < MIN_NODE_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
-                                "number less than %d.\n", MIN_NODE_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is too large */
-            if (user_node_count > MAX_NODE_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be "
-                                "more than %d.\n", MAX_NODE_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            node_count = user_node_count;
+            node_count = parse_int_option(option, optarg, MIN_NODE_COUNT,
+                                          MAX_NODE_COUNT);
         } else {
             exit(EXIT_FAILURE);
         }
@@ -149,7 +136,7 @@ int main(int argc, char *argv[])
     via_node = (int32_t *)malloc(node_count * sizeof(int32_t));
 
     /* Initialize helper arrays and populate distance_matrix */
-    srand(1);
+    random_seed(1);
     for (size_t i = 0; i < node_count; i++) {
         shortest_distances[i] = 0;
         via_node[i] = -1;
@@ -157,13 +144,15 @@ int main(int argc, char *argv[])
     }
     for (size_t i = 0; i < node_count; i++) {
         for (size_t j = i + 1; j < node_count; j++) {
-            distance_matrix[i][j] = 1 + (rand()) / (RAND_MAX / 999);
+            distance_matrix[i][j] = 1 + random_below(999);
             distance_matrix[j][i] = distance_matrix[i][j];
         }
     }
 
+    roi_begin();
     find_shortest_distances(shortest_distances, via_node, &node_eccentricity,
                             node_count, source_node, distance_matrix);
+    roi_end();
 
     /* Control printing */
     printf("CONTROL RESULT:\n");
@@ -189,4 +178,6 @@ int main(int argc, char *argv[])
     free(distance_matrix);
     free(shortest_distances);
     free(via_node);
+
+    return 0;
 }
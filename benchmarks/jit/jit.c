@@ -0,0 +1,301 @@
+/*
+ *  Source file of a benchmark program that behaves like a small JIT
+ *  compiler: it writes machine code stubs into an executable buffer, calls
+ *  them, and regenerates one of them with new constants at a fixed interval.
+ *  Each regeneration modifies code that has already been executed. The
+ *  stubs are called n times in total. The number n can be given via command
+ *  line, and the default is 1000000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
+/* Number of calls of the stubs */
+#define NUMBER_OF_CALLS 1000000
+#define MAX_NUMBER_OF_CALLS 2000000000
+
+/* Number of calls between two regenerations of a stub */
+#define REGENERATION_INTERVAL 1000
+#define MAX_REGENERATION_INTERVAL 2000000000
+
+/* Number of stubs */
+#define NUMBER_OF_STUBS 16
+#define MAX_NUMBER_OF_STUBS 1024
+
+/* Size in bytes reserved for each stub in the executable buffer */
+#define STUB_SIZE 64
+
+/*
+ * Each stub is the machine code of the function
+ *
+ *     uint32_t stub(uint32_t x) { return x * A + B; }
+ *
+ * where A and B are constants encoded as immediates in the instructions, so
+ * a stale translation of a regenerated stub gives a wrong result. The code
+ * emitter of the target writes the stub and returns its size in bytes. On
+ * targets without an emitter, the benchmark does nothing.
+ */
+
+/**
+ * Write a 32-bit instruction or immediate in the byte order of the target.
+ * @param code Address of the word.
+ * @param word Value of the word.
+ * @return The size of the word.
+ */
+static size_t put_word(uint8_t *code, uint32_t word)
+{
+    memcpy(code, &word, sizeof(word));
+    return sizeof(word);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define JIT_TARGET "x86"
+
+static size_t emit_stub(uint8_t *code, uint32_t a, uint32_t b)
+{
+    size_t size = 0;
+
+#ifdef __i386__
+    /* mov eax, [esp + 4]; imul eax, eax, A */
+    code[size++] = 0x8b;
+    code[size++] = 0x44;
+    code[size++] = 0x24;
+    code[size++] = 0x04;
+    code[size++] = 0x69;
+    code[size++] = 0xc0;
+#else
+    /* imul eax, edi, A */
+    code[size++] = 0x69;
+    code[size++] = 0xc7;
+#endif
+    size += put_word(code + size, a);
+    /* add eax, B */
+    code[size++] = 0x05;
+    size += put_word(code + size, b);
+    /* ret */
+    code[size++] = 0xc3;
+    return size;
+}
+
+#elif defined(__aarch64__)
+#define JIT_TARGET "aarch64"
+
+static size_t emit_stub(uint8_t *code, uint32_t a, uint32_t b)
+{
+    size_t size = 0;
+
+    /* movz w1, #A_lo; movk w1, #A_hi, lsl #16 */
+    size += put_word(code + size, 0x52800001 | (a & 0xffff) << 5);
+    size += put_word(code + size, 0x72a00001 | (a >> 16) << 5);
+    /* movz w2, #B_lo; movk w2, #B_hi, lsl #16 */
+    size += put_word(code + size, 0x52800002 | (b & 0xffff) << 5);
+    size += put_word(code + size, 0x72a00002 | (b >> 16) << 5);
+    /* mul w0, w0, w1; add w0, w0, w2; ret */
+    size += put_word(code + size, 0x1b017c00);
+    size += put_word(code + size, 0x0b020000);
+    size += put_word(code + size, 0xd65f03c0);
+    return size;
+}
+
+#elif defined(__arm__) && !defined(__thumb__)
+#define JIT_TARGET "arm"
+
+static size_t emit_stub(uint8_t *code, uint32_t a, uint32_t b)
+{
+    size_t size = 0;
+
+    /* movw r1, #A_lo; movt r1, #A_hi */
+    size += put_word(code + size, 0xe3001000 | (a & 0xf000) << 4 |
+                                      (a & 0x0fff));
+    size += put_word(code + size, 0xe3401000 | (a & 0xf0000000) >> 12 |
+                                      (a & 0x0fff0000) >> 16);
+    /* movw r2, #B_lo; movt r2, #B_hi */
+    size += put_word(code + size, 0xe3002000 | (b & 0xf000) << 4 |
+                                      (b & 0x0fff));
+    size += put_word(code + size, 0xe3402000 | (b & 0xf0000000) >> 12 |
+                                      (b & 0x0fff0000) >> 16);
+    /* mul r0, r0, r1; add r0, r0, r2; bx lr */
+    size += put_word(code + size, 0xe0000190);
+    size += put_word(code + size, 0xe0800002);
+    size += put_word(code + size, 0xe12fff1e);
+    return size;
+}
+
+#elif defined(__riscv) && __riscv_xlen == 64
+#define JIT_TARGET "riscv64"
+
+static size_t emit_stub(uint8_t *code, uint32_t a, uint32_t b)
+{
+    size_t size = 0;
+
+    /*
+     * lui t0, %hi(A); addiw t0, t0, %lo(A). The low 12 bits are sign
+     * extended by addiw, so the upper 20 bits are rounded accordingly.
+     */
+    size += put_word(code + size, 0x000002b7 | ((a + 0x800) & 0xfffff000));
+    size += put_word(code + size, 0x0002829b | (a & 0xfff) << 20);
+    /* lui t1, %hi(B); addiw t1, t1, %lo(B) */
+    size += put_word(code + size, 0x00000337 | ((b + 0x800) & 0xfffff000));
+    size += put_word(code + size, 0x0003031b | (b & 0xfff) << 20);
+    /* mulw a0, a0, t0; addw a0, a0, t1; ret */
+    size += put_word(code + size, 0x0255053b);
+    size += put_word(code + size, 0x0065053b);
+    size += put_word(code + size, 0x00008067);
+    return size;
+}
+
+#elif defined(__mips__) && (!defined(__mips_isa_rev) || __mips_isa_rev < 6)
+/* mult and mflo exist from MIPS I up to R5, and were removed in R6 */
+#define JIT_TARGET "mips"
+
+static size_t emit_stub(uint8_t *code, uint32_t a, uint32_t b)
+{
+    size_t size = 0;
+
+    /* lui $8, %hi(A); ori $8, $8, %lo(A) */
+    size += put_word(code + size, 0x3c080000 | a >> 16);
+    size += put_word(code + size, 0x35080000 | (a & 0xffff));
+    /* lui $9, %hi(B); ori $9, $9, %lo(B) */
+    size += put_word(code + size, 0x3c090000 | b >> 16);
+    size += put_word(code + size, 0x35290000 | (b & 0xffff));
+    /* mult $4, $8; mflo $2; addu $2, $2, $9; jr $31; nop */
+    size += put_word(code + size, 0x00880018);
+    size += put_word(code + size, 0x00001012);
+    size += put_word(code + size, 0x00491021);
+    size += put_word(code + size, 0x03e00008);
+    size += put_word(code + size, 0x00000000);
+    return size;
+}
+
+#endif
+
+#ifdef JIT_TARGET
+/**
+ * Generate a stub with new random constants, and make the new code visible
+ * to the instruction fetch.
+ * @param code Address of the stub.
+ * @param a Set to the multiplier A of the stub.
+ * @param b Set to the addend B of the stub.
+ */
+static void generate_stub(uint8_t *code, uint32_t *a, uint32_t *b)
+{
+    size_t size;
+
+    *a = (uint32_t)random_next() | 1;
+    *b = (uint32_t)random_next();
+    size = emit_stub(code, *a, *b);
+    __builtin___clear_cache((char *)code, (char *)code + size);
+}
+#endif
+
+BENCHMARK_MAIN(jit)
+{
+    int number_of_calls = NUMBER_OF_CALLS;
+    int regeneration_interval = REGENERATION_INTERVAL;
+    int number_of_stubs = NUMBER_OF_STUBS;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:r:s:")) != -1) {
+        if (option == 'n') {
+            number_of_calls = parse_int_option(option, optarg, 1,
+                                               MAX_NUMBER_OF_CALLS);
+        } else if (option == 'r') {
+            regeneration_interval = parse_int_option(
+                option, optarg, 1, MAX_REGENERATION_INTERVAL);
+        } else if (option == 's') {
+            number_of_stubs = parse_int_option(option, optarg, 1,
+                                               MAX_NUMBER_OF_STUBS);
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+#ifdef JIT_TARGET
+    static uint32_t multipliers[MAX_NUMBER_OF_STUBS];
+    static uint32_t addends[MAX_NUMBER_OF_STUBS];
+    uint32_t value = 1;
+    uint32_t expected_value = 1;
+    int number_of_regenerations = 0;
+    uint8_t *buffer;
+
+    /* Allocate a buffer that is both writable and executable */
+    buffer = (uint8_t *)mmap(NULL, number_of_stubs * STUB_SIZE,
+                             PROT_READ | PROT_WRITE | PROT_EXEC,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+        fprintf(stderr, "Error ... Failed to allocate executable memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Seed random function with constant value, then generate all stubs */
+    random_seed(1);
+    for (int s = 0; s < number_of_stubs; s++) {
+        generate_stub(buffer + s * STUB_SIZE, &multipliers[s], &addends[s]);
+    }
+
+    /*
+     * Call the stubs in turn, and regenerate the stub about to be called
+     * once every regeneration_interval calls. The result of each call is
+     * also calculated in C, to verify that the latest code is executed.
+     */
+    roi_begin();
+    for (int i = 0; i < number_of_calls; i++) {
+        int s = i % number_of_stubs;
+        uint8_t *code = buffer + s * STUB_SIZE;
+        uint32_t (*stub)(uint32_t) = (uint32_t (*)(uint32_t))(void *)code;
+
+        if ((i + 1) % regeneration_interval == 0) {
+            generate_stub(code, &multipliers[s], &addends[s]);
+            number_of_regenerations++;
+        }
+        value = stub(value);
+        expected_value = expected_value * multipliers[s] + addends[s];
+    }
+    roi_end();
+
+    if (value != expected_value) {
+        fprintf(stderr, "Error ... The generated code returned %u instead "
+                        "of %u.\n", value, expected_value);
+        exit(EXIT_FAILURE);
+    }
+
+    /* Control printing */
+    printf("CONTROL RESULT:\n");
+    printf(" %u %d\n", value, number_of_regenerations);
+
+    munmap(buffer, number_of_stubs * STUB_SIZE);
+#else
+    /* Control printing */
+    printf("CONTROL RESULT:\n");
+    printf(" no code emitter for this target\n");
+#endif
+
+    return 0;
+}
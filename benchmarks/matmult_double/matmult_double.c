@@ -27,12 +27,16 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
 /* Number of columns and rows in all matrixes*/
 #define DEFAULT_MATRIX_SIZE     200
 #define MIN_MATRIX_SIZE         2
 #define MAX_MATRIX_SIZE         200000
 
-int main(int argc, char *argv[])
+BENCHMARK_MAIN(matmult_double)
 {
     double **matrix_a;
     double **matrix_b;
@@ -42,32 +46,13 @@ int main(int argc, char *argv[])
     size_t k;
     int32_t matrix_size = DEFAULT_MATRIX_SIZE;
     int32_t option;
-    double range_factor = 100.0 / (double)(RAND_MAX);
 
 
     /* Parse command line options */
     while ((option = getopt(argc, argv, "n:")) != -1) {
         if (option == 'n') {
-            int32_t user_matrix_size = atoi(optarg);
-
-            /* Check if the value is a string or zero */
-            if (user_matrix_size == 0) {
-                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is a negative number */
-            if (user_matrix_size < MIN_MATRIX_SIZE) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
-                                "number less than %d.\n", MIN_MATRIX_SIZE);
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is too large */
-            if (user_matrix_size > MAX_MATRIX_SIZE) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be "
-                                "more than %d.\n", MAX_MATRIX_SIZE);
-                exit(EXIT_FAILURE);
-            }
-            matrix_size = user_matrix_size;
+            matrix_size = parse_int_option(option, optarg, MIN_MATRIX_SIZE,
+                                           MAX_MATRIX_SIZE);
         } else {
             exit(EXIT_FAILURE);
         }
@@ -88,15 +73,14 @@ int main(int argc, char *argv[])
     }
 
     /* Populate matrix_a and matrix_b with random numbers */
-    srand(1);
+    random_seed(1);
     for (i = 0; i < matrix_size; i++) {
-        for (j = 0; j < matrix_size; j++) {
-            matrix_a[i][j] = range_factor * (double)rand();
-            matrix_b[i][j] = range_factor * (double)rand();
-        }
+        random_fill_double(matrix_a[i], matrix_size, 100.0);
+        random_fill_double(matrix_b[i], matrix_size, 100.0);
     }
 
     /* Calculate the product of two matrixes */
+    roi_begin();
     for (i = 0; i < matrix_size; i++) {
         for (j = 0; j < matrix_size; j++) {
             matrix_res[i][j] = 0.0;
@@ -105,6 +89,7 @@ int main(int argc, char *argv[])
             }
         }
     }
+    roi_end();
 
     /* Control printing */
     printf("CONTROL RESULT:\n");
@@ -120,4 +105,6 @@ int main(int argc, char *argv[])
     free(matrix_a);
     free(matrix_b);
     free(matrix_res);
+
+    return 0;
 }
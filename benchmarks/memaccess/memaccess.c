@@ -0,0 +1,417 @@
+/*
+ *  Source file of a benchmark program that measures the cost of memory
+ *  accesses with different access patterns over a sweep of working set
+ *  sizes: dependent loads chasing pointers through a random cycle, loads
+ *  with fixed strides, sequential streaming reads, writes and copies, and
+ *  independent loads from random addresses (gather). Each point of the sweep
+ *  makes n accesses and reports the time per access. The number n can be
+ *  given via command line, and the default is 200000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
+/* Number of accesses made at each point of the sweep */
+#define NUMBER_OF_ACCESSES 200000
+#define MAX_NUMBER_OF_ACCESSES 2000000000
+
+/*
+ * Smallest and largest working set sizes of the sweep, in KB. The working
+ * set size is doubled at each point, starting at the smallest size rounded
+ * up to a power of two.
+ */
+#define MIN_WORKING_SET_KB 4
+#define MAX_WORKING_SET_KB 16384
+#define LIMIT_WORKING_SET_KB 1048576
+
+/* Smallest and largest strides of the stride mode, in bytes */
+#define MIN_STRIDE 8
+#define MAX_STRIDE 4096
+
+/*
+ * Size in bytes of the elements of the pointer chasing cycle. Each element
+ * is on its own cache line, so every load of the chase touches a new line.
+ */
+#define CHASE_ELEMENT_SIZE 64
+
+/* Largest number of measurements: points of the sweep times rows per point */
+#define MAX_NUMBER_OF_MEASUREMENTS (19 * 15)
+
+/* Modes of the benchmark */
+enum Mode { CHASE, STRIDE, STREAM, GATHER, NUMBER_OF_MODES };
+
+static const char *mode_names[NUMBER_OF_MODES] = {"chase", "stride", "stream",
+                                                  "gather"};
+
+/**
+ * A struct for a single point of the sweep.
+ */
+struct Measurement {
+    /**
+     * Name of the access pattern.
+     */
+    const char *pattern;
+    /**
+     * Working set size in bytes.
+     */
+    size_t working_set;
+    /**
+     * Distance in bytes between consecutive accesses, 0 for random accesses.
+     */
+    size_t stride;
+    /**
+     * Average time per access in nanoseconds.
+     */
+    double ns_per_access;
+};
+
+static struct Measurement measurements[MAX_NUMBER_OF_MEASUREMENTS];
+static size_t number_of_measurements;
+
+/**
+ * Utility function for reading the monotonic clock in seconds.
+ */
+static double get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/**
+ * Record the result of a point of the sweep.
+ * @param pattern Name of the access pattern.
+ * @param working_set Working set size in bytes.
+ * @param stride Distance in bytes between consecutive accesses.
+ * @param start_time Time at the start of the accesses.
+ * @param number_of_accesses Number of accesses made.
+ */
+static void record(const char *pattern, size_t working_set, size_t stride,
+                   double start_time, int number_of_accesses)
+{
+    struct Measurement *measurement = &measurements[number_of_measurements++];
+
+    (*measurement).ns_per_access =
+        (get_time() - start_time) * 1e9 / number_of_accesses;
+    (*measurement).pattern = pattern;
+    (*measurement).working_set = working_set;
+    (*measurement).stride = stride;
+}
+
+/**
+ * Fill the working set with the index of each 64-bit word, so the loaded
+ * values (and the control result) don't depend on the addresses of the
+ * buffer.
+ * @param buffer Buffer of at least working_set bytes.
+ * @param working_set Working set size in bytes.
+ */
+static void fill_words(char *buffer, size_t working_set)
+{
+    uint64_t *words = (uint64_t *)buffer;
+
+    for (size_t i = 0; i < working_set / sizeof(uint64_t); i++) {
+        words[i] = i;
+    }
+}
+
+/**
+ * Link the elements of the working set into a single random cycle with
+ * Sattolo's algorithm, then follow the cycle with dependent loads.
+ * @param buffer Buffer of at least working_set bytes.
+ * @param working_set Working set size in bytes.
+ * @param number_of_accesses Number of loads.
+ * @return The offset of the last element reached.
+ */
+static uint64_t chase_pointers(char *buffer, size_t working_set,
+                               int number_of_accesses)
+{
+    size_t number_of_elements = working_set / CHASE_ELEMENT_SIZE;
+    void **element;
+    double start_time;
+
+    for (size_t i = 0; i < number_of_elements; i++) {
+        *(void **)(buffer + i * CHASE_ELEMENT_SIZE) =
+            buffer + i * CHASE_ELEMENT_SIZE;
+    }
+    for (size_t i = number_of_elements - 1; i > 0; i--) {
+        void **a = (void **)(buffer + i * CHASE_ELEMENT_SIZE);
+        void **b = (void **)(buffer + random_below(i) * CHASE_ELEMENT_SIZE);
+        void *swap = *a;
+
+        *a = *b;
+        *b = swap;
+    }
+
+    start_time = get_time();
+    element = (void **)buffer;
+    for (int i = 0; i < number_of_accesses; i++) {
+        element = (void **)*element;
+    }
+    record("chase", working_set, 0, start_time, number_of_accesses);
+
+    /* Replace the pointers of the cycle before the other patterns */
+    fill_words(buffer, working_set);
+
+    return (char *)element - buffer;
+}
+
+/**
+ * Load 64-bit words with a fixed stride. When the end of the working set is
+ * reached, the accesses continue from the next word after the start of the
+ * previous pass, so all words are eventually loaded.
+ * @param buffer Buffer of at least working_set bytes.
+ * @param working_set Working set size in bytes.
+ * @param stride Distance in bytes between consecutive loads.
+ * @param number_of_accesses Number of loads.
+ * @return The sum of the loaded words.
+ */
+static uint64_t load_strided(char const *buffer, size_t working_set,
+                             size_t stride, int number_of_accesses)
+{
+    size_t start = 0;
+    size_t offset = 0;
+    uint64_t sum = 0;
+    double start_time = get_time();
+
+    for (int i = 0; i < number_of_accesses; i++) {
+        sum += *(uint64_t const *)(buffer + offset);
+        offset += stride;
+        /*
+         * Wrap around with a compare instead of a remainder, whose division
+         * would be timed with the loads when the stride is the working set
+         * (the stride is a multiple of the word size)
+         */
+        if (offset >= working_set) {
+            start += sizeof(uint64_t);
+            if (start >= stride) {
+                start -= stride;
+            }
+            offset = start;
+        }
+    }
+    record("stride", working_set, stride, start_time, number_of_accesses);
+
+    return sum;
+}
+
+/**
+ * Stream sequentially through the working set with 64-bit reads, with
+ * 64-bit writes, and with a copy from its first half to its second half.
+ * @param buffer Buffer of at least working_set bytes.
+ * @param working_set Working set size in bytes.
+ * @param number_of_accesses Number of words read, written or copied in each
+ * of the three patterns.
+ * @return The sum of the read words, and of two words written by the other
+ * patterns.
+ */
+static uint64_t stream(char *buffer, size_t working_set,
+                       int number_of_accesses)
+{
+    uint64_t *words = (uint64_t *)buffer;
+    size_t number_of_words = working_set / sizeof(uint64_t);
+    size_t half = number_of_words / 2;
+    uint64_t sum = 0;
+    double start_time;
+    int i;
+
+    start_time = get_time();
+    for (i = 0; i < number_of_accesses;) {
+        for (size_t j = 0; j < number_of_words && i < number_of_accesses;
+             j++, i++) {
+            sum += words[j];
+        }
+    }
+    record("read", working_set, sizeof(uint64_t), start_time,
+           number_of_accesses);
+
+    start_time = get_time();
+    for (i = 0; i < number_of_accesses;) {
+        for (size_t j = 0; j < number_of_words && i < number_of_accesses;
+             j++, i++) {
+            words[j] = i;
+        }
+    }
+    record("write", working_set, sizeof(uint64_t), start_time,
+           number_of_accesses);
+    sum += words[number_of_words - 1];
+
+    start_time = get_time();
+    for (i = 0; i < number_of_accesses;) {
+        for (size_t j = 0; j < half && i < number_of_accesses; j++, i++) {
+            words[half + j] = words[j];
+        }
+    }
+    record("copy", working_set, sizeof(uint64_t), start_time,
+           number_of_accesses);
+    sum += words[number_of_words - 1];
+
+    return sum;
+}
+
+/**
+ * Load 64-bit words from random addresses. The addresses are independent of
+ * the loaded values, so unlike the pointer chase, several loads can be in
+ * flight at the same time. The word index is generated with a linear
+ * congruential generator modulo the (power of two) number of words, whose
+ * period is the whole working set.
+ * @param buffer Buffer of at least working_set bytes.
+ * @param working_set Working set size in bytes, a power of two.
+ * @param number_of_accesses Number of loads.
+ * @return The sum of the loaded words.
+ */
+static uint64_t gather(char const *buffer, size_t working_set,
+                       int number_of_accesses)
+{
+    uint64_t const *words = (uint64_t const *)buffer;
+    size_t mask = working_set / sizeof(uint64_t) - 1;
+    size_t index = 0;
+    uint64_t sum = 0;
+    double start_time = get_time();
+
+    for (int i = 0; i < number_of_accesses; i++) {
+        index = (index * 1103515245u + 12345u) & mask;
+        sum += words[index];
+    }
+    record("gather", working_set, 0, start_time, number_of_accesses);
+
+    return sum;
+}
+
+BENCHMARK_MAIN(memaccess)
+{
+    int number_of_accesses = NUMBER_OF_ACCESSES;
+    int min_working_set_kb = MIN_WORKING_SET_KB;
+    int max_working_set_kb = MAX_WORKING_SET_KB;
+    int selected_mode = NUMBER_OF_MODES;
+    size_t min_working_set;
+    size_t max_working_set;
+    uint64_t checksum = 0;
+    char *buffer;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:l:u:m:")) != -1) {
+        if (option == 'n') {
+            number_of_accesses = parse_int_option(option, optarg, 1,
+                                                  MAX_NUMBER_OF_ACCESSES);
+        } else if (option == 'l') {
+            min_working_set_kb = parse_int_option(option, optarg,
+                                                  MIN_WORKING_SET_KB,
+                                                  LIMIT_WORKING_SET_KB);
+        } else if (option == 'u') {
+            max_working_set_kb = parse_int_option(option, optarg,
+                                                  MIN_WORKING_SET_KB,
+                                                  LIMIT_WORKING_SET_KB);
+        } else if (option == 'm') {
+            for (selected_mode = 0; selected_mode < NUMBER_OF_MODES;
+                 selected_mode++) {
+                if (strcmp(optarg, mode_names[selected_mode]) == 0) {
+                    break;
+                }
+            }
+            if (selected_mode == NUMBER_OF_MODES) {
+                fprintf(stderr, "Error ... Invalid value for option "
+                                "'-m'.\n");
+                exit(EXIT_FAILURE);
+            }
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Validate the working set sizes, rounded up to powers of two */
+    min_working_set = 1024;
+    while (min_working_set < (size_t)min_working_set_kb * 1024) {
+        min_working_set *= 2;
+    }
+    max_working_set = (size_t)max_working_set_kb * 1024;
+    if (min_working_set > max_working_set) {
+        fprintf(stderr, "Error ... Value for option '-l' cannot be more than "
+                        "the value for option '-u'.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate the largest working set once, and touch all of its pages */
+    buffer = (char *)malloc(max_working_set);
+    if (buffer == NULL) {
+        fprintf(stderr, "Error ... Cannot allocate a working set of %d KB.\n",
+                max_working_set_kb);
+        exit(EXIT_FAILURE);
+    }
+    fill_words(buffer, max_working_set);
+
+    /* Seed random function with constant value */
+    random_seed(1);
+
+    roi_begin();
+    for (size_t working_set = min_working_set; working_set <= max_working_set;
+         working_set *= 2) {
+        for (int mode = 0; mode < NUMBER_OF_MODES; mode++) {
+            if (selected_mode != NUMBER_OF_MODES && mode != selected_mode) {
+                continue;
+            }
+            if (mode == CHASE) {
+                checksum += chase_pointers(buffer, working_set,
+                                           number_of_accesses);
+            } else if (mode == STRIDE) {
+                for (size_t stride = MIN_STRIDE;
+                     stride <= MAX_STRIDE && stride <= working_set;
+                     stride *= 2) {
+                    checksum += load_strided(buffer, working_set, stride,
+                                             number_of_accesses);
+                }
+            } else if (mode == STREAM) {
+                checksum += stream(buffer, working_set, number_of_accesses);
+            } else {
+                checksum += gather(buffer, working_set, number_of_accesses);
+            }
+        }
+    }
+    roi_end();
+
+    /* Control printing */
+    printf("CONTROL RESULT:\n");
+    printf(" %" PRIu64 "\n", checksum);
+
+    /* Time per access of each point of the sweep */
+    printf("RESULTS:\n");
+    printf(" %-8s %16s %10s %13s\n", "pattern", "working set (KB)",
+           "stride (B)", "ns per access");
+    for (size_t i = 0; i < number_of_measurements; i++) {
+        printf(" %-8s %16zu %10zu %13.3f\n", measurements[i].pattern,
+               measurements[i].working_set / 1024, measurements[i].stride,
+               measurements[i].ns_per_access);
+    }
+
+    free(buffer);
+
+    return 0;
+}
@@ -27,6 +27,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
 /* Number of elements in the array to be sorted */
 #define DEFAULT_ARRAY_LEN       300000
 #define MIN_ARRAY_LEN           3
@@ -46,36 +50,17 @@ static int compare(const void *a, const void *b)
     return 0;
 }
 
-int main(int argc, char *argv[])
+BENCHMARK_MAIN(qsort_double)
 {
     double *array_to_be_sorted;
     int32_t array_len = DEFAULT_ARRAY_LEN;
     int32_t option;
-    double range_factor = UPPER_LIMIT / (double)(RAND_MAX);
 
     /* Parse command line options */
     while ((option = getopt(argc, argv, "n:")) != -1) {
         if (option == 'n') {
-            int32_t user_array_len = atoi(optarg);
-
-            /* Check if the value is a string or zero */
-            if (user_array_len == 0) {
-                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is a negative number */
-            if (user_array_len < MIN_ARRAY_LEN) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
-                                "number less than %d.\n", MIN_ARRAY_LEN);
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is too large */
-            if (user_array_len > MAX_ARRAY_LEN) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be "
-                                "more than %d.\n", MAX_ARRAY_LEN);
-                exit(EXIT_FAILURE);
-            }
-            array_len = user_array_len;
+            array_len = parse_int_option(option, optarg, MIN_ARRAY_LEN,
+                                         MAX_ARRAY_LEN);
         } else {
             exit(EXIT_FAILURE);
         }
@@ -85,14 +70,14 @@ int main(int argc, char *argv[])
     array_to_be_sorted = (double *) malloc(array_len * sizeof(double));
 
     /* Populate the_array with random numbers */
-    srand(1);
-    for (size_t i = 0; i < array_len; i++) {
-        array_to_be_sorted[i] = range_factor * (double)rand();
-    }
+    random_seed(1);
+    random_fill_double(array_to_be_sorted, array_len, UPPER_LIMIT);
 
     /* Sort the_array using qsort() */
+    roi_begin();
     qsort(array_to_be_sorted, array_len, sizeof(array_to_be_sorted[0]),
           compare);
+    roi_end();
 
     /* Control printing */
     printf("CONTROL RESULT:\n");
@@ -101,4 +86,6 @@ int main(int argc, char *argv[])
 
     /* Free all previously allocated space */
     free(array_to_be_sorted);
+
+    return 0;
 }
@@ -30,6 +30,10 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
 /* Length of an individual random string (including terminating zero) */
 #define RANDOM_STRING_LEN             8
 /* Number of elements of the array of random strings */
@@ -46,7 +50,7 @@ struct StringStruct {
 };
 
 /* Comparison function passed to qsort() */
-int compare_strings(const void *element1, const void *element2)
+static int compare_strings(const void *element1, const void *element2)
 {
     int result;
 
@@ -59,16 +63,11 @@ int compare_strings(const void *element1, const void *element2)
 /* Generate a random string of given length and containing only small letters */
 static void gen_random_string(char *s, const int len)
 {
-    static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
-
-    for (size_t i = 0; i < (len - 1); i++) {
-        s[i] = letters[rand() % (sizeof(letters) - 1)];
-    }
-
+    random_fill_letters(s, len - 1);
     s[len - 1] = 0;
 }
 
-int main(int argc, char *argv[])
+BENCHMARK_MAIN(qsort_string)
 {
     struct StringStruct strings_to_be_sorted[NUMBER_OF_RANDOM_STRINGS];
     int32_t repetition_count = DEFAULT_REPETITION_COUNT;
@@ -77,33 +76,17 @@ int main(int argc, char *argv[])
     /* Parse command line options */
     while ((option = getopt(argc, argv, "n:")) != -1) {
         if (option == 'n') {
-            int32_t user_repetition_count = atoi(optarg);
-
-            /* Check if the value is a string or zero */
-            if (user_repetition_count == 0) {
-                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is a negative number */
-            if (user_repetition_count < MIN_REPETITION_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
-                                "number less than %d.\n", MIN_REPETITION_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is too large */
-            if (user_repetition_count > MAX_REPETITION_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be "
-                                "more than %d.\n", MAX_REPETITION_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            repetition_count = user_repetition_count;
+            repetition_count = parse_int_option(option, optarg,
+                                                MIN_REPETITION_COUNT,
+                                                MAX_REPETITION_COUNT);
         } else {
             exit(EXIT_FAILURE);
         }
     }
 
-    srand(1);
+    random_seed(1);
 
+    roi_begin();
     for (size_t i = 0; i < repetition_count; ++i) {
         /* Generate random strings, and, in turn, sort them */
         for (size_t i = 0; i < NUMBER_OF_RANDOM_STRINGS; ++i) {
@@ -112,6 +95,7 @@ int main(int argc, char *argv[])
         qsort(strings_to_be_sorted, NUMBER_OF_RANDOM_STRINGS,
               sizeof(struct StringStruct), compare_strings);
     }
+    roi_end();
 
     /* Control printing */
     printf("CONTROL RESULT:\n");
@@ -119,4 +103,6 @@ int main(int argc, char *argv[])
         printf(" %s", strings_to_be_sorted[i].chars);
     }
     printf("\n");
+
+    return 0;
 }
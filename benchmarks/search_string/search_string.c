@@ -30,6 +30,10 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#include "../common/benchmark.h"
+#include "../common/random.h"
+#include "../common/roi.h"
+
 /* Length of a long string to be searched (including terminating zero) */
 #define HAYSTACK_LEN                  30000
 
@@ -42,16 +46,11 @@
 /* Generate a random string of given length and containing only small letters */
 static void gen_random_string(char *s, const int len)
 {
-    static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
-
-    for (size_t i = 0; i < (len - 1); i++) {
-        s[i] = letters[rand() % (sizeof(letters) - 1)];
-    }
-
+    random_fill_letters(s, len - 1);
     s[len - 1] = 0;
 }
 
-int main(int argc, char *argv[])
+BENCHMARK_MAIN(search_string)
 {
     char haystack[HAYSTACK_LEN];
     const char needle[] = "aaa ";
@@ -66,33 +65,17 @@ int main(int argc, char *argv[])
     /* Parse command line options */
     while ((option = getopt(argc, argv, "n:")) != -1) {
         if (option == 'n') {
-            int32_t user_repetition_count = atoi(optarg);
-
-            /* Check if the value is a string or zero */
-            if (user_repetition_count == 0) {
-                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is a negative number */
-            if (user_repetition_count < MIN_REPETITION_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
-                                "number less than %d.\n", MIN_REPETITION_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            /* Check if the value is too large */
-            if (user_repetition_count > MAX_REPETITION_COUNT) {
-                fprintf(stderr, "Error ... Value for option '-n' cannot be "
-                                "more than %d.\n", MAX_REPETITION_COUNT);
-                exit(EXIT_FAILURE);
-            }
-            repetition_count = user_repetition_count;
+            repetition_count = parse_int_option(option, optarg,
+                                                MIN_REPETITION_COUNT,
+                                                MAX_REPETITION_COUNT);
         } else {
             exit(EXIT_FAILURE);
         }
     }
 
-    srand(1);
+    random_seed(1);
 
+    roi_begin();
     for (size_t i = 0; i < repetition_count; ++i) {
         /* Generate random hay, and, in turn, find a needle */
         gen_random_string(haystack, HAYSTACK_LEN);
@@ -103,8 +86,11 @@ int main(int argc, char *argv[])
             not_found_cnt++;
         }
     }
+    roi_end();
 
     /* Control printing */
     printf("CONTROL RESULT:\n");
     printf(" Found %d times. Not found %d times.\n", found_cnt, not_found_cnt);
+
+    return 0;
 }
@@ -0,0 +1,252 @@
+/*
+ *  Source file of a benchmark program that measures the cost of cheap system
+ *  calls: getpid(), clock_gettime(), a write() and read() of one byte
+ *  through a pipe, an mmap() and munmap() of one page, and a futex wake with
+ *  no waiters. Each system call is made n times in a tight loop, and the
+ *  time per call is reported. The number n can be given via command line,
+ *  and the default is 100000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <linux/futex.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../common/benchmark.h"
+#include "../common/roi.h"
+
+/* Number of iterations of each system call loop */
+#define NUMBER_OF_CALLS 100000
+#define MAX_NUMBER_OF_CALLS 2000000000
+
+/**
+ * A struct for a loop of system calls.
+ */
+struct SyscallLoop {
+    /**
+     * Name of the loop, used for selecting it with '-s'.
+     */
+    const char *name;
+    /**
+     * Number of system calls made in each iteration of the loop.
+     */
+    int calls_per_iteration;
+    /**
+     * Run the loop. It returns the number of iterations whose system calls
+     * all succeeded.
+     */
+    int (*run)(int number_of_iterations);
+};
+
+/* Both ends of the pipe used by the pipe loop */
+static int pipe_fds[2];
+
+/* The futex word of the futex loop */
+static uint32_t futex_word;
+
+/**
+ * Call getpid(). The system call is made directly, since some C libraries
+ * cache the process ID.
+ * @param number_of_iterations Number of calls.
+ * @return The number of successful calls.
+ */
+static int run_getpid(int number_of_iterations)
+{
+    int successful = 0;
+
+    for (int i = 0; i < number_of_iterations; i++) {
+        successful += syscall(SYS_getpid) > 0;
+    }
+    return successful;
+}
+
+/**
+ * Call clock_gettime() of the C library, which some targets implement in
+ * the vDSO without a system call.
+ * @param number_of_iterations Number of calls.
+ * @return The number of successful calls.
+ */
+static int run_clock_gettime(int number_of_iterations)
+{
+    struct timespec now;
+    int successful = 0;
+
+    for (int i = 0; i < number_of_iterations; i++) {
+        successful += clock_gettime(CLOCK_MONOTONIC, &now) == 0;
+    }
+    return successful;
+}
+
+/**
+ * Write one byte to the pipe, then read it back.
+ * @param number_of_iterations Number of write() and read() pairs.
+ * @return The number of pairs that transferred the byte.
+ */
+static int run_pipe(int number_of_iterations)
+{
+    char byte = 'x';
+    int successful = 0;
+
+    for (int i = 0; i < number_of_iterations; i++) {
+        successful += write(pipe_fds[1], &byte, 1) == 1 &&
+                      read(pipe_fds[0], &byte, 1) == 1;
+    }
+    return successful;
+}
+
+/**
+ * Map one anonymous page, then unmap it. The page is never touched, so no
+ * page fault is taken.
+ * @param number_of_iterations Number of mmap() and munmap() pairs.
+ * @return The number of successful pairs.
+ */
+static int run_mmap(int number_of_iterations)
+{
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    int successful = 0;
+
+    for (int i = 0; i < number_of_iterations; i++) {
+        void *page = mmap(NULL, page_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (page != MAP_FAILED) {
+            successful += munmap(page, page_size) == 0;
+        }
+    }
+    return successful;
+}
+
+/**
+ * Wake the waiters of a futex that has none.
+ * @param number_of_iterations Number of calls.
+ * @return The number of successful calls (that woke no waiter).
+ */
+static int run_futex(int number_of_iterations)
+{
+    int successful = 0;
+
+    for (int i = 0; i < number_of_iterations; i++) {
+        successful += syscall(SYS_futex, &futex_word, FUTEX_WAKE_PRIVATE, 1,
+                              NULL, NULL, 0) == 0;
+    }
+    return successful;
+}
+
+static const struct SyscallLoop loops[] = {
+    {"getpid", 1, run_getpid},
+    {"clock_gettime", 1, run_clock_gettime},
+    {"pipe", 2, run_pipe},
+    {"mmap", 2, run_mmap},
+    {"futex", 1, run_futex},
+};
+
+#define NUMBER_OF_LOOPS (sizeof(loops) / sizeof(loops[0]))
+
+/**
+ * Utility function for reading the monotonic clock in seconds.
+ */
+static double get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+BENCHMARK_MAIN(syscalls)
+{
+    int number_of_calls = NUMBER_OF_CALLS;
+    const char *selected_loop = NULL;
+    int successful[NUMBER_OF_LOOPS] = {0};
+    double times[NUMBER_OF_LOOPS] = {0};
+    size_t i;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:s:")) != -1) {
+        if (option == 'n') {
+            number_of_calls = parse_int_option(option, optarg, 1,
+                                               MAX_NUMBER_OF_CALLS);
+        } else if (option == 's') {
+            selected_loop = optarg;
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Validate the loop given with '-s' */
+    for (i = 0; i < NUMBER_OF_LOOPS && selected_loop != NULL; i++) {
+        if (strcmp(selected_loop, loops[i].name) == 0) {
+            break;
+        }
+    }
+    if (i == NUMBER_OF_LOOPS) {
+        fprintf(stderr, "Error ... Invalid value for option '-s'.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (pipe(pipe_fds)) {
+        fprintf(stderr, "Error ... Failed to create a pipe.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Time each loop separately */
+    roi_begin();
+    for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+        double start_time;
+
+        if (selected_loop != NULL && strcmp(selected_loop, loops[i].name)) {
+            continue;
+        }
+        start_time = get_time();
+        successful[i] = loops[i].run(number_of_calls);
+        times[i] = get_time() - start_time;
+    }
+    roi_end();
+
+    /* Control printing */
+    printf("CONTROL RESULT:\n");
+    for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+        printf(" %-14s %d\n", loops[i].name, successful[i]);
+    }
+
+    /* Time per system call of each loop */
+    printf("RESULTS:\n");
+    printf(" %-14s %11s\n", "syscall", "ns per call");
+    for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+        if (selected_loop != NULL && strcmp(selected_loop, loops[i].name)) {
+            continue;
+        }
+        printf(" %-14s %11.1f\n", loops[i].name,
+               times[i] * 1e9 / number_of_calls /
+                   loops[i].calls_per_iteration);
+    }
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+
+    return 0;
+}
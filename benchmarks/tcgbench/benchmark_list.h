@@ -0,0 +1,52 @@
+/*
+ *  Registry of the benchmarks linked into the tcgbench driver.
+ *
+ *  Each line registers a benchmark with BENCHMARK(name), where name is the
+ *  name given to BENCHMARK_MAIN() in its source file. The file is included
+ *  several times by tcgbench.c, each time with a different definition of the
+ *  BENCHMARK() macro, so it has no include guard.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+BENCHMARK(codesize)
+BENCHMARK(coulomb_double)
+BENCHMARK(coulomb_double_fastmath)
+BENCHMARK(coulomb_float)
+BENCHMARK(coulomb_float128)
+BENCHMARK(coulomb_longdouble)
+BENCHMARK(dijkstra_double)
+BENCHMARK(dijkstra_int32)
+BENCHMARK(interp_goto)
+BENCHMARK(interp_switch)
+BENCHMARK(jit)
+BENCHMARK(matmult_double)
+BENCHMARK(matmult_int32)
+BENCHMARK(memaccess)
+BENCHMARK(qsort_double)
+BENCHMARK(qsort_int32)
+BENCHMARK(qsort_string)
+BENCHMARK(search_string)
+BENCHMARK(syscalls)
+BENCHMARK(threads_barrier)
+BENCHMARK(threads_compute)
+BENCHMARK(threads_contended)
+BENCHMARK(threads_lockfree)
+BENCHMARK(threads_padded)
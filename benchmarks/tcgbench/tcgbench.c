@@ -0,0 +1,176 @@
+/*
+ *  Multi-call driver that links all benchmarks into a single program.
+ *
+ *  Syntax:
+ *    tcgbench [-l] [-t] <benchmark> [<benchmark options>]
+ *
+ *  The driver and the sources of all benchmarks in the other directories
+ *  are compiled into one executable with -DTCGBENCH. Adding a benchmark only
+ *  requires using BENCHMARK_MAIN() in its source and registering it in
+ *  benchmark_list.h.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../common/benchmark.h"
+
+/* Declare the entry points of all registered benchmarks */
+#define BENCHMARK(NAME) int BENCHMARK_ENTRY(NAME)(int argc, char *argv[]);
+#include "benchmark_list.h"
+#undef BENCHMARK
+
+/**
+ * A struct for an entry of the benchmark registry.
+ */
+struct Benchmark {
+    /**
+     * The name the benchmark is selected with.
+     */
+    const char *name;
+    /**
+     * The entry point of the benchmark, called with the arguments that follow
+     * the name of the benchmark.
+     */
+    int (*main)(int argc, char *argv[]);
+};
+
+static const struct Benchmark benchmarks[] = {
+#define BENCHMARK(NAME) {#NAME, BENCHMARK_ENTRY(NAME)},
+#include "benchmark_list.h"
+#undef BENCHMARK
+};
+
+#define NUMBER_OF_BENCHMARKS (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/**
+ * Find a benchmark in the registry.
+ * @param name Name of the benchmark.
+ * @return The registry entry, or NULL if there is no benchmark with the name.
+ */
+static const struct Benchmark *find_benchmark(const char *name)
+{
+    for (size_t i = 0; i < NUMBER_OF_BENCHMARKS; i++) {
+        if (strcmp(benchmarks[i].name, name) == 0) {
+            return &benchmarks[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Print the syntax of the driver and the names of all benchmarks.
+ * @param stream Stream the text is printed to.
+ */
+static void print_usage(FILE *stream)
+{
+    fprintf(stream, "Usage: tcgbench [-l] [-t] <benchmark> "
+                    "[<benchmark options>]\n"
+                    "  -l  List the benchmarks\n"
+                    "  -t  Print the execution time of the benchmark on "
+                    "stderr\n"
+                    "Benchmarks:\n");
+    for (size_t i = 0; i < NUMBER_OF_BENCHMARKS; i++) {
+        fprintf(stream, "  %s\n", benchmarks[i].name);
+    }
+}
+
+/**
+ * Utility function for reading the monotonic clock in seconds.
+ */
+static double get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+    const struct Benchmark *benchmark;
+    const char *program_name = strrchr(argv[0], '/');
+    bool print_time = false;
+    int first_arg = 1;
+    double start_time;
+    int result;
+
+    /*
+     * If the driver is called through a link named after a benchmark, run
+     * that benchmark with all arguments, like a separate executable.
+     */
+    program_name = program_name != NULL ? program_name + 1 : argv[0];
+    benchmark = find_benchmark(program_name);
+    if (benchmark != NULL) {
+        return (*benchmark).main(argc, argv);
+    }
+
+    /* Parse the options of the driver, which precede the benchmark name */
+    while (first_arg < argc && argv[first_arg][0] == '-') {
+        if (strcmp(argv[first_arg], "-l") == 0) {
+            for (size_t i = 0; i < NUMBER_OF_BENCHMARKS; i++) {
+                printf("%s\n", benchmarks[i].name);
+            }
+            return 0;
+        } else if (strcmp(argv[first_arg], "-t") == 0) {
+            print_time = true;
+        } else if (strcmp(argv[first_arg], "-h") == 0) {
+            print_usage(stdout);
+            return 0;
+        } else {
+            fprintf(stderr, "Error ... Invalid option '%s'.\n",
+                    argv[first_arg]);
+            print_usage(stderr);
+            exit(EXIT_FAILURE);
+        }
+        first_arg++;
+    }
+
+    if (first_arg == argc) {
+        print_usage(stderr);
+        exit(EXIT_FAILURE);
+    }
+    benchmark = find_benchmark(argv[first_arg]);
+    if (benchmark == NULL) {
+        fprintf(stderr, "Error ... Unknown benchmark '%s'.\n",
+                argv[first_arg]);
+        print_usage(stderr);
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * The benchmark sees its name as argv[0], so its getopt() loop parses the
+     * remaining arguments as usual.
+     */
+    start_time = get_time();
+    result = (*benchmark).main(argc - first_arg, argv + first_arg);
+    if (print_time) {
+        fflush(stdout);
+        fprintf(stderr, "TIME: %s %.6f s\n", (*benchmark).name,
+                get_time() - start_time);
+    }
+
+    return result;
+}
@@ -0,0 +1,163 @@
+/*
+ *  Source file of a benchmark program that measures the scaling of a kernel
+ *  made of n short phases separated by barriers. In each phase, every
+ *  element of an array is updated from the values of the element and of its
+ *  neighbor in the previous phase, and all threads wait on a barrier before
+ *  the next phase. The number n can be given via command line, and the
+ *  default is 20000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+
+#include "threads.c.inc"
+
+/* Number of phases */
+#define NUMBER_OF_PHASES 20000
+#define MAX_NUMBER_OF_PHASES 2000000000
+
+/* Number of array elements updated in each phase, shared by all threads */
+#define NUMBER_OF_ELEMENTS 1024
+#define MAX_NUMBER_OF_ELEMENTS 100000000
+
+/**
+ * A struct for the state shared by the threads of the phased kernel.
+ */
+struct Phases {
+    /**
+     * The barrier all threads wait on at the end of each phase.
+     */
+    pthread_barrier_t barrier;
+    /**
+     * Whether the barrier has been initialized.
+     */
+    bool barrier_initialized;
+    /**
+     * The array in the previous and in the current phase. Phase p reads
+     * buffers[p % 2] and writes buffers[(p + 1) % 2].
+     */
+    uint32_t *buffers[2];
+    /**
+     * Number of elements of the array.
+     */
+    size_t number_of_elements;
+    /**
+     * Number of phases.
+     */
+    int number_of_phases;
+};
+
+/**
+ * Initialize the array and the barrier for the number of threads of a run.
+ * @param shared A pointer to the Phases object.
+ * @param number_of_threads Number of threads of the run.
+ */
+static void prepare_phases(void *shared, size_t number_of_threads)
+{
+    struct Phases *phases = (struct Phases *)shared;
+
+    if ((*phases).barrier_initialized) {
+        pthread_barrier_destroy(&(*phases).barrier);
+    }
+    if (pthread_barrier_init(&(*phases).barrier, NULL, number_of_threads)) {
+        fprintf(stderr, "Error ... Failed to initialize the barrier.\n");
+        exit(EXIT_FAILURE);
+    }
+    (*phases).barrier_initialized = true;
+
+    for (size_t i = 0; i < (*phases).number_of_elements; i++) {
+        (*phases).buffers[0][i] = i;
+    }
+}
+
+/**
+ * Run all phases for the elements assigned to a thread.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The sum of the elements of the thread after the last phase.
+ */
+static uint64_t run_phases(struct ThreadWork *work)
+{
+    struct Phases *phases = (struct Phases *)(*work).shared;
+    size_t number_of_elements = (*phases).number_of_elements;
+    uint64_t sum = 0;
+
+    for (int p = 0; p < (*phases).number_of_phases; p++) {
+        uint32_t const *source = (*phases).buffers[p % 2];
+        uint32_t *destination = (*phases).buffers[(p + 1) % 2];
+
+        for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+            uint32_t neighbor = source[i + 1 < number_of_elements ? i + 1 : 0];
+
+            destination[i] = source[i] * 2654435761u + (neighbor >> 7) + p;
+        }
+        pthread_barrier_wait(&(*phases).barrier);
+    }
+
+    for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+        sum += (*phases).buffers[(*phases).number_of_phases % 2][i];
+    }
+    return sum;
+}
+
+BENCHMARK_MAIN(threads_barrier)
+{
+    struct Phases phases;
+    struct Kernel kernel = {prepare_phases, run_phases, &phases};
+    int number_of_phases = NUMBER_OF_PHASES;
+    int number_of_elements = NUMBER_OF_ELEMENTS;
+    int number_of_threads = NUMBER_OF_THREADS;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:w:t:")) != -1) {
+        if (option == 'n') {
+            number_of_phases = parse_int_option(option, optarg, 1,
+                                                MAX_NUMBER_OF_PHASES);
+        } else if (option == 'w') {
+            number_of_elements = parse_int_option(option, optarg, 1,
+                                                  MAX_NUMBER_OF_ELEMENTS);
+        } else if (option == 't') {
+            number_of_threads = parse_int_option(option, optarg, 1,
+                                                 MAX_NUMBER_OF_THREADS);
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    phases.barrier_initialized = false;
+    phases.number_of_elements = number_of_elements;
+    phases.number_of_phases = number_of_phases;
+    for (int b = 0; b < 2; b++) {
+        phases.buffers[b] =
+            (uint32_t *)malloc(number_of_elements * sizeof(uint32_t));
+        if (phases.buffers[b] == NULL) {
+            fprintf(stderr, "Error ... Failed to allocate the array.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    measure_scaling(&kernel, number_of_elements, number_of_threads);
+
+    pthread_barrier_destroy(&phases.barrier);
+    free(phases.buffers[0]);
+    free(phases.buffers[1]);
+
+    return 0;
+}
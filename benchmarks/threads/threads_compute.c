@@ -0,0 +1,91 @@
+/*
+ *  Source file of a benchmark program that measures the scaling of an
+ *  embarrassingly parallel integer computation. Each of the n work items is
+ *  hashed independently, and the threads only share the read only input. The
+ *  number n can be given via command line, and the default is 1000000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "threads.c.inc"
+
+/* Number of work items shared by all threads */
+#define NUMBER_OF_ITEMS 1000000
+#define MAX_NUMBER_OF_ITEMS 2000000000
+
+/* Number of rounds of the hash function applied to each item */
+#define NUMBER_OF_ROUNDS 32
+
+/**
+ * Hash a work item with several rounds of the finalizer of splitmix64.
+ * @param item Index of the work item.
+ * @return The hash of the item.
+ */
+static uint64_t hash_item(uint64_t item)
+{
+    uint64_t x = item;
+
+    for (int round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        x += UINT64_C(0x9e3779b97f4a7c15);
+        x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
+        x ^= x >> 31;
+    }
+    return x;
+}
+
+/**
+ * Hash all work items of a thread.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The sum of the hashes of the items.
+ */
+static uint64_t hash_items(struct ThreadWork *work)
+{
+    uint64_t sum = 0;
+
+    for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+        sum += hash_item(i);
+    }
+    return sum;
+}
+
+BENCHMARK_MAIN(threads_compute)
+{
+    struct Kernel kernel = {NULL, hash_items, NULL};
+    int number_of_items = NUMBER_OF_ITEMS;
+    int number_of_threads = NUMBER_OF_THREADS;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:t:")) != -1) {
+        if (option == 'n') {
+            number_of_items = parse_int_option(option, optarg, 1,
+                                               MAX_NUMBER_OF_ITEMS);
+        } else if (option == 't') {
+            number_of_threads = parse_int_option(option, optarg, 1,
+                                                 MAX_NUMBER_OF_THREADS);
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    measure_scaling(&kernel, number_of_items, number_of_threads);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ *  Source file of a benchmark program that measures the scaling of n
+ *  increments, shared by all threads, of a single counter. All threads
+ *  increment the same counter with an atomic read-modify-write operation,
+ *  or under a mutex, so every increment is contended. The number n can be
+ *  given via command line, and the default is 2000000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+
+#include "threads.c.inc"
+
+/* Number of increments shared by all threads */
+#define NUMBER_OF_INCREMENTS 2000000
+#define MAX_NUMBER_OF_INCREMENTS 2000000000
+
+/**
+ * A struct for the counter shared by all threads.
+ */
+struct SharedCounter {
+    /**
+     * The counter. It is 32 bits wide, so the atomic operations are native
+     * on all targets.
+     */
+    uint32_t value;
+    /**
+     * The mutex protecting the counter in the mutex mode.
+     */
+    pthread_mutex_t mutex;
+    /**
+     * Whether the counter is incremented under the mutex instead of with an
+     * atomic operation.
+     */
+    bool use_mutex;
+};
+
+/**
+ * Reset the shared counter before a run.
+ * @param shared A pointer to the SharedCounter object.
+ * @param number_of_threads Number of threads of the run.
+ */
+static void reset_counter(void *shared, size_t number_of_threads)
+{
+    (*(struct SharedCounter *)shared).value = 0;
+}
+
+/**
+ * Increment the shared counter once for each work item of a thread.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The sum of the values of the counter before each increment. Each
+ * value from 0 to n - 1 is seen by exactly one increment, so the sum over
+ * all threads is n * (n - 1) / 2 if no increment is lost.
+ */
+static uint64_t increment_shared_counter(struct ThreadWork *work)
+{
+    struct SharedCounter *counter = (struct SharedCounter *)(*work).shared;
+    uint64_t sum = 0;
+
+    if ((*counter).use_mutex) {
+        for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+            pthread_mutex_lock(&(*counter).mutex);
+            sum += (*counter).value++;
+            pthread_mutex_unlock(&(*counter).mutex);
+        }
+    } else {
+        for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+            sum += __atomic_fetch_add(&(*counter).value, 1, __ATOMIC_SEQ_CST);
+        }
+    }
+    return sum;
+}
+
+BENCHMARK_MAIN(threads_contended)
+{
+    struct SharedCounter counter = {0, PTHREAD_MUTEX_INITIALIZER, false};
+    struct Kernel kernel = {reset_counter, increment_shared_counter, &counter};
+    int number_of_increments = NUMBER_OF_INCREMENTS;
+    int number_of_threads = NUMBER_OF_THREADS;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:t:m")) != -1) {
+        if (option == 'n') {
+            number_of_increments = parse_int_option(option, optarg, 1,
+                                                    MAX_NUMBER_OF_INCREMENTS);
+        } else if (option == 't') {
+            number_of_threads = parse_int_option(option, optarg, 1,
+                                                 MAX_NUMBER_OF_THREADS);
+        } else if (option == 'm') {
+            counter.use_mutex = true;
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    measure_scaling(&kernel, number_of_increments, number_of_threads);
+
+    return 0;
+}
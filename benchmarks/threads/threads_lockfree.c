@@ -0,0 +1,363 @@
+/*
+ *  Source file of a benchmark program that measures the scaling of lock-free
+ *  data structures built on the atomic operations of the target: a
+ *  Michael-Scott queue and a Treiber stack, where each of n operations
+ *  inserts and then removes an element, and a histogram of n values whose
+ *  bins are incremented with atomic fetch-and-add. The number n can be given
+ *  via command line, and the default is 500000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "threads.c.inc"
+
+/* Number of operations shared by all threads */
+#define NUMBER_OF_OPERATIONS 500000
+#define MAX_NUMBER_OF_OPERATIONS 100000000
+
+/* Number of bins of the histogram */
+#define NUMBER_OF_BINS 64
+
+/* Number of data structures: queue, stack and histogram */
+#define NUMBER_OF_STRUCTURES 3
+
+/**
+ * A struct for an element of the queue and of the stack.
+ */
+struct Node {
+    /**
+     * The next element, toward the tail of the queue or the bottom of the
+     * stack.
+     */
+    struct Node *next;
+    /**
+     * The value stored in the element.
+     */
+    uint32_t value;
+};
+
+/**
+ * A struct for the state shared by the threads of the lock-free kernels.
+ * The elements are never reused during a run: operation i of the queue and
+ * stack kernels inserts nodes[i], so the ABA problem can't occur, and the
+ * removed elements don't need to be reclaimed while other threads may still
+ * read them.
+ */
+struct LockFree {
+    /**
+     * The head of the queue, from which elements are removed.
+     */
+    struct Node *head;
+    char head_padding[CACHE_LINE_SIZE - sizeof(struct Node *)];
+    /**
+     * The tail of the queue, to which elements are inserted.
+     */
+    struct Node *tail;
+    char tail_padding[CACHE_LINE_SIZE - sizeof(struct Node *)];
+    /**
+     * The top of the stack.
+     */
+    struct Node *top;
+    char top_padding[CACHE_LINE_SIZE - sizeof(struct Node *)];
+    /**
+     * The bins of the histogram.
+     */
+    uint32_t bins[NUMBER_OF_BINS];
+    /**
+     * The elements inserted by the operations, followed by the initial dummy
+     * element of the queue.
+     */
+    struct Node *nodes;
+    /**
+     * Number of operations.
+     */
+    size_t number_of_operations;
+};
+
+/**
+ * Reset the queue, the stack and the histogram before a run.
+ * @param shared A pointer to the LockFree object.
+ * @param number_of_threads Number of threads of the run.
+ */
+static void reset_lockfree(void *shared, size_t number_of_threads)
+{
+    struct LockFree *lockfree = (struct LockFree *)shared;
+    struct Node *dummy = &(*lockfree).nodes[(*lockfree).number_of_operations];
+
+    (*dummy).next = NULL;
+    (*lockfree).head = dummy;
+    (*lockfree).tail = dummy;
+    (*lockfree).top = NULL;
+    memset((*lockfree).bins, 0, sizeof((*lockfree).bins));
+}
+
+/**
+ * Insert an element at the tail of the Michael-Scott queue.
+ * @param lockfree A pointer to the LockFree object.
+ * @param node The element to be inserted.
+ */
+static void enqueue(struct LockFree *lockfree, struct Node *node)
+{
+    (*node).next = NULL;
+    while (true) {
+        struct Node *tail = __atomic_load_n(&(*lockfree).tail,
+                                            __ATOMIC_ACQUIRE);
+        struct Node *next = __atomic_load_n(&(*tail).next, __ATOMIC_ACQUIRE);
+
+        if (tail != __atomic_load_n(&(*lockfree).tail, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        if (next == NULL) {
+            /* Link the element after the last one, then swing the tail */
+            if (__atomic_compare_exchange_n(&(*tail).next, &next, node, false,
+                                            __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED)) {
+                __atomic_compare_exchange_n(&(*lockfree).tail, &tail, node,
+                                            false, __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED);
+                return;
+            }
+        } else {
+            /* The tail is lagging behind, help the other thread advance it */
+            __atomic_compare_exchange_n(&(*lockfree).tail, &tail, next, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Remove the element at the head of the Michael-Scott queue.
+ * @param lockfree A pointer to the LockFree object.
+ * @param value Set to the value of the removed element.
+ * @return False if the queue is empty.
+ */
+static bool dequeue(struct LockFree *lockfree, uint32_t *value)
+{
+    while (true) {
+        struct Node *head = __atomic_load_n(&(*lockfree).head,
+                                            __ATOMIC_ACQUIRE);
+        struct Node *tail = __atomic_load_n(&(*lockfree).tail,
+                                            __ATOMIC_ACQUIRE);
+        struct Node *next = __atomic_load_n(&(*head).next, __ATOMIC_ACQUIRE);
+
+        if (head != __atomic_load_n(&(*lockfree).head, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        if (head == tail) {
+            if (next == NULL) {
+                return false;
+            }
+            __atomic_compare_exchange_n(&(*lockfree).tail, &tail, next, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        } else {
+            /* The first element is a dummy, the value is in the next one */
+            *value = (*next).value;
+            if (__atomic_compare_exchange_n(&(*lockfree).head, &head, next,
+                                            false, __ATOMIC_ACQ_REL,
+                                            __ATOMIC_RELAXED)) {
+                return true;
+            }
+        }
+    }
+}
+
+/**
+ * Push an element on the Treiber stack.
+ * @param lockfree A pointer to the LockFree object.
+ * @param node The element to be pushed.
+ */
+static void push(struct LockFree *lockfree, struct Node *node)
+{
+    struct Node *top = __atomic_load_n(&(*lockfree).top, __ATOMIC_RELAXED);
+
+    do {
+        (*node).next = top;
+    } while (!__atomic_compare_exchange_n(&(*lockfree).top, &top, node, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+ * Pop the element at the top of the Treiber stack.
+ * @param lockfree A pointer to the LockFree object.
+ * @param value Set to the value of the popped element.
+ * @return False if the stack is empty.
+ */
+static bool pop(struct LockFree *lockfree, uint32_t *value)
+{
+    struct Node *top = __atomic_load_n(&(*lockfree).top, __ATOMIC_ACQUIRE);
+
+    do {
+        if (top == NULL) {
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(&(*lockfree).top, &top, (*top).next,
+                                          true, __ATOMIC_ACQUIRE,
+                                          __ATOMIC_ACQUIRE));
+    *value = (*top).value;
+    return true;
+}
+
+/**
+ * Insert and then remove one element of the queue for each operation of a
+ * thread. Each thread removes an element after inserting one, so the queue
+ * is never empty when an element is removed.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The sum of the values of the removed elements. All inserted
+ * elements are removed, so the sum over all threads is n * (n - 1) / 2.
+ */
+static uint64_t run_queue(struct ThreadWork *work)
+{
+    struct LockFree *lockfree = (struct LockFree *)(*work).shared;
+    uint64_t sum = 0;
+    uint32_t value;
+
+    for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+        (*lockfree).nodes[i].value = i;
+        enqueue(lockfree, &(*lockfree).nodes[i]);
+        if (!dequeue(lockfree, &value)) {
+            fprintf(stderr, "Error ... The queue is unexpectedly empty.\n");
+            exit(EXIT_FAILURE);
+        }
+        sum += value;
+    }
+    return sum;
+}
+
+/**
+ * Push and then pop one element of the stack for each operation of a
+ * thread.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The sum of the values of the popped elements, which is
+ * n * (n - 1) / 2 over all threads.
+ */
+static uint64_t run_stack(struct ThreadWork *work)
+{
+    struct LockFree *lockfree = (struct LockFree *)(*work).shared;
+    uint64_t sum = 0;
+    uint32_t value;
+
+    for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+        (*lockfree).nodes[i].value = i;
+        push(lockfree, &(*lockfree).nodes[i]);
+        if (!pop(lockfree, &value)) {
+            fprintf(stderr, "Error ... The stack is unexpectedly empty.\n");
+            exit(EXIT_FAILURE);
+        }
+        sum += value;
+    }
+    return sum;
+}
+
+/**
+ * Add the values of the operations of a thread to the histogram. The value
+ * of operation i is a hash of i, and its bin is incremented with an atomic
+ * fetch-and-add.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The sum of the counts of the bins before each increment. The
+ * increments of a bin with a final count c see each count from 0 to c - 1
+ * once, so the sum over all threads doesn't depend on their order.
+ */
+static uint64_t run_histogram(struct ThreadWork *work)
+{
+    struct LockFree *lockfree = (struct LockFree *)(*work).shared;
+    uint64_t sum = 0;
+
+    for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+        uint32_t bin = ((uint32_t)i * 2654435761u >> 16) % NUMBER_OF_BINS;
+
+        sum += __atomic_fetch_add(&(*lockfree).bins[bin], 1,
+                                  __ATOMIC_SEQ_CST);
+    }
+    return sum;
+}
+
+BENCHMARK_MAIN(threads_lockfree)
+{
+    static const char *structure_names[] = {"queue", "stack", "histogram"};
+    uint64_t (*const structure_kernels[])(struct ThreadWork *) = {
+        run_queue, run_stack, run_histogram};
+    struct LockFree *lockfree;
+    int number_of_operations = NUMBER_OF_OPERATIONS;
+    int number_of_threads = NUMBER_OF_THREADS;
+    const char *structure = NULL;
+    bool structure_found = false;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:t:s:")) != -1) {
+        if (option == 'n') {
+            number_of_operations = parse_int_option(option, optarg, 1,
+                                                    MAX_NUMBER_OF_OPERATIONS);
+        } else if (option == 't') {
+            number_of_threads = parse_int_option(option, optarg, 1,
+                                                 MAX_NUMBER_OF_THREADS);
+        } else if (option == 's') {
+            structure = optarg;
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Validate the data structure given with '-s' */
+    for (size_t s = 0; s < NUMBER_OF_STRUCTURES && structure != NULL; s++) {
+        if (strcmp(structure, structure_names[s]) == 0) {
+            structure_found = true;
+        }
+    }
+    if (structure != NULL && !structure_found) {
+        fprintf(stderr, "Error ... Invalid value for option '-s'.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate the shared state and the elements of the queue and stack */
+    lockfree = (struct LockFree *)aligned_alloc(
+        CACHE_LINE_SIZE, (sizeof(struct LockFree) + CACHE_LINE_SIZE - 1) /
+                             CACHE_LINE_SIZE * CACHE_LINE_SIZE);
+    if (lockfree == NULL) {
+        fprintf(stderr, "Error ... Failed to allocate the data structures.\n");
+        exit(EXIT_FAILURE);
+    }
+    (*lockfree).number_of_operations = number_of_operations;
+    (*lockfree).nodes = (struct Node *)malloc((number_of_operations + 1) *
+                                              sizeof(struct Node));
+    if ((*lockfree).nodes == NULL) {
+        fprintf(stderr, "Error ... Failed to allocate the data structures.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Measure all data structures, or only the one given with '-s' */
+    for (size_t s = 0; s < NUMBER_OF_STRUCTURES; s++) {
+        struct Kernel kernel = {reset_lockfree, structure_kernels[s],
+                                lockfree};
+
+        if (structure != NULL && strcmp(structure, structure_names[s]) != 0) {
+            continue;
+        }
+        printf("STRUCTURE: %s\n", structure_names[s]);
+        measure_scaling(&kernel, number_of_operations, number_of_threads);
+    }
+
+    free((*lockfree).nodes);
+    free(lockfree);
+
+    return 0;
+}
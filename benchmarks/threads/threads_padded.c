@@ -0,0 +1,124 @@
+/*
+ *  Source file of a benchmark program that measures the scaling of n counter
+ *  increments, shared by all threads, where each thread increments its own
+ *  counter in memory. The counters are padded to separate cache lines, so
+ *  the threads never write to the same cache line. The number n can be given
+ *  via command line, and the default is 20000000.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "threads.c.inc"
+
+/* Number of increments shared by all threads */
+#define NUMBER_OF_INCREMENTS 20000000
+#define MAX_NUMBER_OF_INCREMENTS 2000000000
+
+/**
+ * A struct for the per-thread counters.
+ */
+struct Counters {
+    /**
+     * The counters of all threads. The counter of thread t is values[t *
+     * stride].
+     */
+    uint64_t *values;
+    /**
+     * Distance between the counters of two threads, in counters.
+     */
+    size_t stride;
+};
+
+/**
+ * Reset the counters of all threads before a run.
+ * @param shared A pointer to the Counters object.
+ * @param number_of_threads Number of threads of the run.
+ */
+static void reset_counters(void *shared, size_t number_of_threads)
+{
+    struct Counters *counters = (struct Counters *)shared;
+
+    memset((*counters).values, 0,
+           number_of_threads * (*counters).stride * sizeof(uint64_t));
+}
+
+/**
+ * Increment the counter of a thread once for each of its work items. The
+ * counter is accessed through a volatile pointer, so each increment loads
+ * and stores it.
+ * @param work A pointer to the ThreadWork object of the thread.
+ * @return The final value of the counter.
+ */
+static uint64_t increment_counter(struct ThreadWork *work)
+{
+    struct Counters *counters = (struct Counters *)(*work).shared;
+    volatile uint64_t *counter =
+        &(*counters).values[(*work).thread_index * (*counters).stride];
+
+    for (size_t i = (*work).first_item; i < (*work).last_item; i++) {
+        (*counter)++;
+    }
+    return *counter;
+}
+
+BENCHMARK_MAIN(threads_padded)
+{
+    struct Counters counters;
+    struct Kernel kernel = {reset_counters, increment_counter, &counters};
+    int number_of_increments = NUMBER_OF_INCREMENTS;
+    int number_of_threads = NUMBER_OF_THREADS;
+    bool unpadded = false;
+    int option;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:t:u")) != -1) {
+        if (option == 'n') {
+            number_of_increments = parse_int_option(option, optarg, 1,
+                                                    MAX_NUMBER_OF_INCREMENTS);
+        } else if (option == 't') {
+            number_of_threads = parse_int_option(option, optarg, 1,
+                                                 MAX_NUMBER_OF_THREADS);
+        } else if (option == 'u') {
+            unpadded = true;
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /*
+     * Allocate one cache line per thread, or pack the counters next to each
+     * other to measure the cost of false sharing.
+     */
+    counters.stride = unpadded ? 1 : CACHE_LINE_SIZE / sizeof(uint64_t);
+    counters.values = (uint64_t *)aligned_alloc(
+        CACHE_LINE_SIZE, MAX_NUMBER_OF_THREADS * CACHE_LINE_SIZE);
+    if (counters.values == NULL) {
+        fprintf(stderr, "Error ... Failed to allocate the counters.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    measure_scaling(&kernel, number_of_increments, number_of_threads);
+
+    free(counters.values);
+
+    return 0;
+}
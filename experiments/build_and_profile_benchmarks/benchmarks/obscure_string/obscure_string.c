@@ -22,21 +22,33 @@
  *
  */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
 
-#define MAX_STRING_LENGHT              15
-#define NUMBER_OF_RANDOM_STRINGS       100
+#define DEFAULT_STRING_LENGTH          15
+#define MAX_STRING_LENGTH              1000000000
+#define DEFAULT_NUMBER_OF_STRINGS      100
+#define MAX_NUMBER_OF_STRINGS          1000000000
+#define MAX_BUFFER_SIZE                (1 << 30)
 #define DEFAULT_NUMBER_OF_REPETITIONS  30000
 #define MAX_NUMBER_OF_REPETITIONS      1000000000
 #define NUMBER_OF_CONTROL_PRINT_ITEMS  5
+#define CONTROL_PRINT_LENGTH           15
 
-/* Structure for keeping an array of strings */
-struct StringStruct {
-    char chars[MAX_STRING_LENGHT + 1];
-};
+/* Mask of the highest bit of each byte of a 64-bit word */
+#define HIGH_BITS                      0x8080808080808080ULL
+
+/* Vectors of 16 and 32 characters */
+typedef signed char v16qi __attribute__((vector_size(16)));
+#ifdef __AVX2__
+typedef signed char v32qi __attribute__((vector_size(32)));
+#endif
+
+/* Number of characters processed in each step of the SIMD32 kernel */
+#define SIMD32_BLOCK_SIZE              32
 
 /**
  * Sets characters of the given string to random small letters a-z.
@@ -53,15 +65,148 @@ static void gen_random_string(char *chars, const int len)
     chars[len] = 0;
 }
 
+/**
+ * Byte kernel: the characters of each string are obscured one at a time by
+ * xoring them with 42, until the end of the string.
+ * @param strings Array of strings to be processed, stored one after another.
+ * @param count Number of strings in the array.
+ * @param length Length of each string.
+ */
+static void obscure_byte(char *strings, size_t count, size_t length)
+{
+    for (size_t i = 0; i < count; i++) {
+        char *chars = strings + i * (length + 1);
+        int k = 0;
+
+        while (chars[k]) {
+            char ch = chars[k] ^ 42;
+            memcpy((void *)chars + k,
+                   &ch, 1);
+            k++;
+        }
+    }
+}
+
+/**
+ * Utility function for processing the bytes at the end of the array that
+ * don't fill a whole word or vector. Only non-zero bytes are processed, so
+ * the terminating zeros of the strings are kept.
+ * @param chars Array of characters to be processed.
+ * @param start Index of the first character to be processed.
+ * @param size Number of characters in the array.
+ */
+static void obscure_tail(char *chars, size_t start, size_t size)
+{
+    for (size_t k = start; k < size; k++) {
+        if (chars[k]) {
+            chars[k] = chars[k] ^ 42;
+        }
+    }
+}
+
+/**
+ * SWAR kernel: the characters of all strings are processed eight at a time
+ * as 64-bit words. A mask of the non-zero bytes of each word keeps the
+ * terminating zeros of the strings unchanged.
+ * @param strings Array of strings to be processed, stored one after another.
+ * @param count Number of strings in the array.
+ * @param length Length of each string.
+ */
+static void obscure_swar(char *strings, size_t count, size_t length)
+{
+    char *chars = strings;
+    size_t size = count * (length + 1);
+    size_t k;
+
+    for (k = 0; k + sizeof(uint64_t) <= size; k += sizeof(uint64_t)) {
+        uint64_t word, non_zero, mask;
+
+        memcpy(&word, chars + k, sizeof(word));
+        /* The highest bit of each non-zero byte is set */
+        non_zero = (((word & ~HIGH_BITS) + ~HIGH_BITS) | word) & HIGH_BITS;
+        mask = (non_zero >> 7) * 0xff;
+        word ^= 0x2a2a2a2a2a2a2a2aULL & mask;
+        memcpy(chars + k, &word, sizeof(word));
+    }
+    obscure_tail(chars, k, size);
+}
+
+/**
+ * SIMD kernel: the characters of all strings are processed 16 at a time.
+ * GCC lowers the vector operations to SSE2 on x86_64, NEON on aarch64, and
+ * to scalar code on targets without SIMD units.
+ * @param strings Array of strings to be processed, stored one after another.
+ * @param count Number of strings in the array.
+ * @param length Length of each string.
+ */
+static void obscure_simd16(char *strings, size_t count, size_t length)
+{
+    char *chars = strings;
+    size_t size = count * (length + 1);
+    size_t k;
+
+    for (k = 0; k + sizeof(v16qi) <= size; k += sizeof(v16qi)) {
+        v16qi block;
+
+        memcpy(&block, chars + k, sizeof(block));
+        /* Comparisons set the non-zero bytes to -1 */
+        block ^= (block != 0) & 42;
+        memcpy(chars + k, &block, sizeof(block));
+    }
+    obscure_tail(chars, k, size);
+}
+
+/**
+ * SIMD kernel: the characters of all strings are processed 32 at a time.
+ * When AVX2 is enabled (for example with -mavx2), 32-byte vectors are used.
+ * Otherwise, GCC would lower the comparisons of 32-byte vectors to scalar
+ * code, so each step is done as two 16-byte halves.
+ * @param strings Array of strings to be processed, stored one after another.
+ * @param count Number of strings in the array.
+ * @param length Length of each string.
+ */
+static void obscure_simd32(char *strings, size_t count, size_t length)
+{
+    char *chars = strings;
+    size_t size = count * (length + 1);
+    size_t k;
+
+    for (k = 0; k + SIMD32_BLOCK_SIZE <= size; k += SIMD32_BLOCK_SIZE) {
+#ifdef __AVX2__
+        v32qi block;
+
+        memcpy(&block, chars + k, sizeof(block));
+        /* Comparisons set the non-zero bytes to -1 */
+        block ^= (block != 0) & 42;
+        memcpy(chars + k, &block, sizeof(block));
+#else
+        v16qi low, high;
+
+        memcpy(&low, chars + k, sizeof(low));
+        memcpy(&high, chars + k + sizeof(low), sizeof(high));
+        /* Comparisons set the non-zero bytes to -1 */
+        low ^= (low != 0) & 42;
+        high ^= (high != 0) & 42;
+        memcpy(chars + k, &low, sizeof(low));
+        memcpy(chars + k + sizeof(low), &high, sizeof(high));
+#endif
+    }
+    obscure_tail(chars, k, size);
+}
+
 void main (int argc, char* argv[])
 {
-    struct StringStruct random_strings[NUMBER_OF_RANDOM_STRINGS];
-    struct StringStruct strings_to_be_obscured[NUMBER_OF_RANDOM_STRINGS];
+    char *random_strings;
+    char *strings_to_be_obscured;
+    size_t string_length = DEFAULT_STRING_LENGTH;
+    size_t number_of_strings = DEFAULT_NUMBER_OF_STRINGS;
+    size_t buffer_size;
     int32_t number_of_repetitions = DEFAULT_NUMBER_OF_REPETITIONS;
     int32_t option;
+    void (*obscure_kernel)(char *, size_t, size_t) = obscure_byte;
 
     /* Parse command line options */
-    while ((option = getopt(argc, argv, "n:")) != -1) {
+    while ((option = getopt(argc, argv, "n:k:l:c:")) != -1) {
         if (option == 'n') {
             int32_t user_number_of_repetitions = atoi(optarg);
             /* Check if the value is a negative number */
@@ -82,43 +227,113 @@ void main (int argc, char* argv[])
                 exit(EXIT_FAILURE);
             }
             number_of_repetitions = user_number_of_repetitions;
+        } else if (option == 'l') {
+            int32_t user_string_length = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_string_length < 1) {
+                fprintf(stderr, "Error ... Value for option '-l' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_string_length == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-l'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_string_length > MAX_STRING_LENGTH) {
+                fprintf(stderr, "Error ... Value for option '-l' cannot be "
+                                "more than %d.\n", MAX_STRING_LENGTH);
+                exit(EXIT_FAILURE);
+            }
+            string_length = user_string_length;
+        } else if (option == 'c') {
+            int32_t user_number_of_strings = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_number_of_strings < 1) {
+                fprintf(stderr, "Error ... Value for option '-c' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_number_of_strings == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-c'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_number_of_strings > MAX_NUMBER_OF_STRINGS) {
+                fprintf(stderr, "Error ... Value for option '-c' cannot be "
+                                "more than %d.\n", MAX_NUMBER_OF_STRINGS);
+                exit(EXIT_FAILURE);
+            }
+            number_of_strings = user_number_of_strings;
+        } else if (option == 'k') {
+            /* Select the kernel used for processing the strings */
+            if (!strcmp(optarg, "byte")) {
+                obscure_kernel = obscure_byte;
+            } else if (!strcmp(optarg, "swar")) {
+                obscure_kernel = obscure_swar;
+            } else if (!strcmp(optarg, "simd16")) {
+                obscure_kernel = obscure_simd16;
+            } else if (!strcmp(optarg, "simd32")) {
+                obscure_kernel = obscure_simd32;
+            } else {
+                fprintf(stderr, "Error ... Value for option '-k' must be "
+                                "'byte', 'swar', 'simd16' or 'simd32'.\n");
+                exit(EXIT_FAILURE);
+            }
         } else {
             exit(EXIT_FAILURE);
         }
     }
 
+    /* Check that the strings fit in the largest supported buffer */
+    if ((uint64_t)(string_length + 1) * number_of_strings > MAX_BUFFER_SIZE) {
+        fprintf(stderr, "Error ... Strings cannot take more than %d bytes.\n",
+                MAX_BUFFER_SIZE);
+        exit(EXIT_FAILURE);
+    }
+    buffer_size = (string_length + 1) * number_of_strings;
+
+    /* Allocate the strings on the heap, one after another */
+    random_strings = malloc(buffer_size);
+    strings_to_be_obscured = malloc(buffer_size);
+    if (random_strings == NULL || strings_to_be_obscured == NULL) {
+        fprintf(stderr, "Error ... Failed to allocate the strings.\n");
+        exit(EXIT_FAILURE);
+    }
+
     /* Create an array of strings with random content */
     srand(1);
-    for (size_t i = 0; i < NUMBER_OF_RANDOM_STRINGS; i++) {
-        gen_random_string(random_strings[i].chars, MAX_STRING_LENGHT);
+    for (size_t i = 0; i < number_of_strings; i++) {
+        gen_random_string(random_strings + i * (string_length + 1),
+                          string_length);
     }
 
     /* Perform uppercasing of a set of random strings multiple times */
     for (size_t j = 0; j < number_of_repetitions; j++) {
         /* Copy initial set of random strings to the set to be obscured */
-        memcpy(strings_to_be_obscured, random_strings,
-               NUMBER_OF_RANDOM_STRINGS * (MAX_STRING_LENGHT + 1));
+        memcpy(strings_to_be_obscured, random_strings, buffer_size);
         /* Do actual changing case to uppercase */
-        for (size_t i = 0; i < NUMBER_OF_RANDOM_STRINGS; i++) {
-            int k = 0;
-  
-            while (strings_to_be_obscured[i].chars[k]) { 
-                char ch = strings_to_be_obscured[i].chars[k] ^ 42; 
-                memcpy((void *)strings_to_be_obscured[i].chars + k,
-                       &ch, 1);
-                k++; 
-            } 
-        }
+        obscure_kernel(strings_to_be_obscured, number_of_strings,
+                       string_length);
     }
 
     /* Control printing */
     printf("CONTROL RESULT: (obscure_string)\n");
-    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS; i++) {
-        printf(" %s", random_strings[i].chars);
+    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS &&
+                       i < number_of_strings; i++) {
+        printf(" %.*s", CONTROL_PRINT_LENGTH,
+               random_strings + i * (string_length + 1));
     }
     printf("\n");
-    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS; i++) {
-        printf(" %s", strings_to_be_obscured[i].chars);
+    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS &&
+                       i < number_of_strings; i++) {
+        printf(" %.*s", CONTROL_PRINT_LENGTH,
+               strings_to_be_obscured + i * (string_length + 1));
     }
     printf("\n");
+
+    free(random_strings);
+    free(strings_to_be_obscured);
 }
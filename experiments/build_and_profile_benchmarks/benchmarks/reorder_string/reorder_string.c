@@ -33,6 +33,10 @@
 #define DEFAULT_NUMBER_OF_REPETITIONS  30000
 #define MAX_NUMBER_OF_REPETITIONS      1000000000
 #define NUMBER_OF_CONTROL_PRINT_ITEMS  5
+#define NUMBER_OF_LETTERS              26
+
+/* Vector of 16 characters, wide enough for a whole string */
+typedef signed char v16qi __attribute__((vector_size(16)));
 
 /* Structure for keeping an array of strings */
 struct StringStruct {
@@ -74,15 +78,119 @@ void reorder(char *str)
     }
 }
 
+/**
+ * Order characters in a given string in alphabethical order using a counting
+ * sort: the occurrences of each of the small letters a-z are counted first,
+ * and the letters are then written back in order.
+ * @param str A string of small letters whose characters are to be reodered.
+ */
+void reorder_counting(char *str)
+{
+    int counts[NUMBER_OF_LETTERS] = {0};
+    char *out = str;
+
+    for (char *c = str; *c != 0; c++) {
+        counts[*c - 'a']++;
+    }
+    for (size_t i = 0; i < NUMBER_OF_LETTERS; i++) {
+        for (int j = 0; j < counts[i]; j++) {
+            *out++ = 'a' + i;
+        }
+    }
+}
+
+/**
+ * Compare two characters of the string 'str' and exchange them if they are
+ * out of order, without branching on the result of the comparison.
+ */
+#define SORT_PAIR(i, j)                             \
+    do {                                            \
+        int a = str[i];                             \
+        int b = str[j];                             \
+        int diff = (a ^ b) & -(a > b);              \
+        str[i] = a ^ diff;                          \
+        str[j] = b ^ diff;                          \
+    } while (0)
+
+/**
+ * Order characters in a given string in alphabethical order using a fixed
+ * sorting network for strings of MAX_STRING_LENGHT characters. The network
+ * is Batcher's odd-even merge sort of 16 elements without the comparators
+ * of the last element: 59 comparators in 10 layers.
+ * @param str A string of MAX_STRING_LENGHT characters to be reodered.
+ */
+void reorder_network(char *str)
+{
+    SORT_PAIR(0, 1); SORT_PAIR(2, 3); SORT_PAIR(4, 5); SORT_PAIR(6, 7);
+    SORT_PAIR(8, 9); SORT_PAIR(10, 11); SORT_PAIR(12, 13);
+
+    SORT_PAIR(0, 2); SORT_PAIR(1, 3); SORT_PAIR(4, 6); SORT_PAIR(5, 7);
+    SORT_PAIR(8, 10); SORT_PAIR(9, 11); SORT_PAIR(12, 14);
+
+    SORT_PAIR(1, 2); SORT_PAIR(5, 6); SORT_PAIR(9, 10); SORT_PAIR(13, 14);
+
+    SORT_PAIR(0, 4); SORT_PAIR(1, 5); SORT_PAIR(2, 6); SORT_PAIR(3, 7);
+    SORT_PAIR(8, 12); SORT_PAIR(9, 13); SORT_PAIR(10, 14);
+
+    SORT_PAIR(2, 4); SORT_PAIR(3, 5); SORT_PAIR(10, 12); SORT_PAIR(11, 13);
+
+    SORT_PAIR(1, 2); SORT_PAIR(3, 4); SORT_PAIR(5, 6); SORT_PAIR(9, 10);
+    SORT_PAIR(11, 12); SORT_PAIR(13, 14);
+
+    SORT_PAIR(0, 8); SORT_PAIR(1, 9); SORT_PAIR(2, 10); SORT_PAIR(3, 11);
+    SORT_PAIR(4, 12); SORT_PAIR(5, 13); SORT_PAIR(6, 14);
+
+    SORT_PAIR(4, 8); SORT_PAIR(5, 9); SORT_PAIR(6, 10); SORT_PAIR(7, 11);
+
+    SORT_PAIR(2, 4); SORT_PAIR(3, 5); SORT_PAIR(6, 8); SORT_PAIR(7, 9);
+    SORT_PAIR(10, 12); SORT_PAIR(11, 13);
+
+    SORT_PAIR(1, 2); SORT_PAIR(3, 4); SORT_PAIR(5, 6); SORT_PAIR(7, 8);
+    SORT_PAIR(9, 10); SORT_PAIR(11, 12); SORT_PAIR(13, 14);
+}
+
+#undef SORT_PAIR
+
+/**
+ * Order characters in a given string in alphabethical order by computing the
+ * final position (rank) of all characters at once with vector operations.
+ * The rank of a character is the number of smaller characters plus the
+ * number of equal characters before it. GCC lowers the vector operations to
+ * SSE2 on x86_64, NEON on aarch64, and to scalar code on targets without
+ * SIMD units.
+ * @param str A string of MAX_STRING_LENGHT characters to be reodered.
+ */
+void reorder_simd(char *str)
+{
+    static const v16qi lane_index = {0, 1, 2, 3, 4, 5, 6, 7,
+                                     8, 9, 10, 11, 12, 13, 14, 15};
+    char ordered[MAX_STRING_LENGHT];
+    v16qi chars, ranks = {0};
+
+    memcpy(&chars, str, sizeof(chars));
+    for (int j = 0; j < MAX_STRING_LENGHT; j++) {
+        v16qi other = (v16qi){0} + (signed char)str[j];
+        v16qi index = (v16qi){0} + (signed char)j;
+        /* Comparisons set the lanes where they are true to -1 */
+        ranks -= chars > other;
+        ranks -= (chars == other) & (lane_index > index);
+    }
+    for (size_t i = 0; i < MAX_STRING_LENGHT; i++) {
+        ordered[ranks[i]] = str[i];
+    }
+    memcpy(str, ordered, MAX_STRING_LENGHT);
+}
+
 void main (int argc, char* argv[])
 {
     struct StringStruct random_strings[NUMBER_OF_RANDOM_STRINGS];
     struct StringStruct strings_to_be_ordered[NUMBER_OF_RANDOM_STRINGS];
     int32_t number_of_repetitions = DEFAULT_NUMBER_OF_REPETITIONS;
     int32_t option;
+    void (*reorder_kernel)(char *) = reorder;
 
     /* Parse command line options */
-    while ((option = getopt(argc, argv, "n:")) != -1) {
+    while ((option = getopt(argc, argv, "n:k:")) != -1) {
         if (option == 'n') {
             int32_t user_number_of_repetitions = atoi(optarg);
             /* Check if the value is a negative number */
@@ -103,6 +211,22 @@ void main (int argc, char* argv[])
                 exit(EXIT_FAILURE);
             }
             number_of_repetitions = user_number_of_repetitions;
+        } else if (option == 'k') {
+            /* Select the kernel used for ordering the strings */
+            if (!strcmp(optarg, "exchange")) {
+                reorder_kernel = reorder;
+            } else if (!strcmp(optarg, "counting")) {
+                reorder_kernel = reorder_counting;
+            } else if (!strcmp(optarg, "network")) {
+                reorder_kernel = reorder_network;
+            } else if (!strcmp(optarg, "simd")) {
+                reorder_kernel = reorder_simd;
+            } else {
+                fprintf(stderr, "Error ... Value for option '-k' must be "
+                                "'exchange', 'counting', 'network' or "
+                                "'simd'.\n");
+                exit(EXIT_FAILURE);
+            }
         } else {
             exit(EXIT_FAILURE);
         }
@@ -119,9 +243,9 @@ void main (int argc, char* argv[])
         /* Copy initial set of random strings to the set to be reversed */
         memcpy(strings_to_be_ordered, random_strings,
                NUMBER_OF_RANDOM_STRINGS * (MAX_STRING_LENGHT + 1));
-        /* Do actual reversing using previously defined reverse() */
+        /* Do actual reordering using the selected kernel */
         for (size_t i = 0; i < NUMBER_OF_RANDOM_STRINGS; i++) {
-            reorder(strings_to_be_ordered[i].chars);
+            reorder_kernel(strings_to_be_ordered[i].chars);
         }
     }
 
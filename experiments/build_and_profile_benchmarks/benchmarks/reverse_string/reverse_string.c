@@ -22,21 +22,21 @@
  *
  */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
 
-#define MAX_STRING_LENGHT              15
-#define NUMBER_OF_RANDOM_STRINGS       100
+#define DEFAULT_STRING_LENGTH          15
+#define MAX_STRING_LENGTH              1000000000
+#define DEFAULT_NUMBER_OF_STRINGS      100
+#define MAX_NUMBER_OF_STRINGS          1000000000
+#define MAX_BUFFER_SIZE                (1 << 30)
 #define DEFAULT_NUMBER_OF_REPETITIONS  30000
 #define MAX_NUMBER_OF_REPETITIONS      1000000000
 #define NUMBER_OF_CONTROL_PRINT_ITEMS  5
-
-/* Structure for keeping an array of strings */
-struct StringStruct {
-    char chars[MAX_STRING_LENGHT + 1];
-};
+#define CONTROL_PRINT_LENGTH           15
 
 /**
  * Sets characters of the given string to random small letters a-z.
@@ -75,13 +75,16 @@ void reverse(char *str)
 
 void main (int argc, char* argv[])
 {
-    struct StringStruct random_strings[NUMBER_OF_RANDOM_STRINGS];
-    struct StringStruct strings_to_be_reversed[NUMBER_OF_RANDOM_STRINGS];
+    char *random_strings;
+    char *strings_to_be_reversed;
+    size_t string_length = DEFAULT_STRING_LENGTH;
+    size_t number_of_strings = DEFAULT_NUMBER_OF_STRINGS;
+    size_t buffer_size;
     int32_t number_of_repetitions = DEFAULT_NUMBER_OF_REPETITIONS;
     int32_t option;
 
     /* Parse command line options */
-    while ((option = getopt(argc, argv, "n:")) != -1) {
+    while ((option = getopt(argc, argv, "n:l:c:")) != -1) {
         if (option == 'n') {
             int32_t user_number_of_repetitions = atoi(optarg);
             /* Check if the value is a negative number */
@@ -102,36 +105,99 @@ void main (int argc, char* argv[])
                 exit(EXIT_FAILURE);
             }
             number_of_repetitions = user_number_of_repetitions;
+        } else if (option == 'l') {
+            int32_t user_string_length = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_string_length < 1) {
+                fprintf(stderr, "Error ... Value for option '-l' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_string_length == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-l'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_string_length > MAX_STRING_LENGTH) {
+                fprintf(stderr, "Error ... Value for option '-l' cannot be "
+                                "more than %d.\n", MAX_STRING_LENGTH);
+                exit(EXIT_FAILURE);
+            }
+            string_length = user_string_length;
+        } else if (option == 'c') {
+            int32_t user_number_of_strings = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_number_of_strings < 1) {
+                fprintf(stderr, "Error ... Value for option '-c' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_number_of_strings == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-c'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_number_of_strings > MAX_NUMBER_OF_STRINGS) {
+                fprintf(stderr, "Error ... Value for option '-c' cannot be "
+                                "more than %d.\n", MAX_NUMBER_OF_STRINGS);
+                exit(EXIT_FAILURE);
+            }
+            number_of_strings = user_number_of_strings;
         } else {
             exit(EXIT_FAILURE);
         }
     }
 
+    /* Check that the strings fit in the largest supported buffer */
+    if ((uint64_t)(string_length + 1) * number_of_strings > MAX_BUFFER_SIZE) {
+        fprintf(stderr, "Error ... Strings cannot take more than %d bytes.\n",
+                MAX_BUFFER_SIZE);
+        exit(EXIT_FAILURE);
+    }
+    buffer_size = (string_length + 1) * number_of_strings;
+
+    /* Allocate the strings on the heap, one after another */
+    random_strings = malloc(buffer_size);
+    strings_to_be_reversed = malloc(buffer_size);
+    if (random_strings == NULL || strings_to_be_reversed == NULL) {
+        fprintf(stderr, "Error ... Failed to allocate the strings.\n");
+        exit(EXIT_FAILURE);
+    }
+
     /* Create an array of strings with random content */
     srand(1);
-    for (size_t i = 0; i < NUMBER_OF_RANDOM_STRINGS; i++) {
-        gen_random_string(random_strings[i].chars, MAX_STRING_LENGHT);
+    for (size_t i = 0; i < number_of_strings; i++) {
+        gen_random_string(random_strings + i * (string_length + 1),
+                          string_length);
     }
 
     /* Perform reversing of a set of random strings multiple times */
     for (size_t j = 0; j < number_of_repetitions; j++) {
         /* Copy initial set of random strings to the set to be reversed */
-        memcpy(strings_to_be_reversed, random_strings,
-               NUMBER_OF_RANDOM_STRINGS * (MAX_STRING_LENGHT + 1));
+        memcpy(strings_to_be_reversed, random_strings, buffer_size);
         /* Do actual reversing using previously defined reverse() */
-        for (size_t i = 0; i < NUMBER_OF_RANDOM_STRINGS; i++) {
-            reverse(strings_to_be_reversed[i].chars);
+        for (size_t i = 0; i < number_of_strings; i++) {
+            reverse(strings_to_be_reversed + i * (string_length + 1));
         }
     }
 
     /* Control printing */
     printf("CONTROL RESULT: (reverse_string)\n");
-    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS; i++) {
-        printf(" %s", random_strings[i].chars);
+    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS &&
+                       i < number_of_strings; i++) {
+        printf(" %.*s", CONTROL_PRINT_LENGTH,
+               random_strings + i * (string_length + 1));
     }
     printf("\n");
-    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS; i++) {
-        printf(" %s", strings_to_be_reversed[i].chars);
+    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS &&
+                       i < number_of_strings; i++) {
+        printf(" %.*s", CONTROL_PRINT_LENGTH,
+               strings_to_be_reversed + i * (string_length + 1));
     }
     printf("\n");
+
+    free(random_strings);
+    free(strings_to_be_reversed);
 }
@@ -0,0 +1,407 @@
+/*
+ *  Source file of a benchmark program involving repeated finding all
+ *  occurrences of a set of random substrings in a set of random strings of
+ *  a constant length, into which the substrings are planted.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define DEFAULT_STRING_LENGTH          15
+#define MAX_STRING_LENGTH              1000000000
+#define DEFAULT_NUMBER_OF_STRINGS      100
+#define MAX_NUMBER_OF_STRINGS          1000000000
+#define MAX_BUFFER_SIZE                (1 << 30)
+#define DEFAULT_NUMBER_OF_REPETITIONS  30000
+#define MAX_NUMBER_OF_REPETITIONS      1000000000
+#define NUMBER_OF_CONTROL_PRINT_ITEMS  5
+#define CONTROL_PRINT_LENGTH           15
+#define NUMBER_OF_SUBSTRINGS           8
+#define MAX_SUBSTRING_LENGTH           8
+
+/* Structure for keeping a substring and its KMP failure table */
+struct Substring {
+    char chars[MAX_SUBSTRING_LENGTH + 1];
+    size_t length;
+    size_t failure[MAX_SUBSTRING_LENGTH];
+};
+
+/*
+ * Length of each substring, and its period. The substrings with a period
+ * of 0 are random letters. The others repeat a random prefix of the given
+ * period (for example "ababab"), so that their KMP failure tables are not
+ * trivial and their occurrences can overlap.
+ */
+static const size_t substring_lengths[NUMBER_OF_SUBSTRINGS] = {
+    3, 4, 6, 8, 4, 6, 7, 8
+};
+static const size_t substring_periods[NUMBER_OF_SUBSTRINGS] = {
+    0, 0, 0, 0, 1, 2, 3, 2
+};
+
+/**
+ * Sets characters of the given string to random small letters a-z.
+ * @param s String to get random characters.
+ * @len Length of the input string.
+ */
+static void gen_random_string(char *chars, const int len)
+{
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
+
+    for (size_t i = 0; i < len; i++) {
+        chars[i] = letters[rand() % (sizeof(letters) - 1)];
+    }
+    chars[len] = 0;
+}
+
+/**
+ * Sets the characters of a substring. A substring with a period repeats
+ * its first period characters up to its length. The last of these differs
+ * from the first one, so the period is not shorter than requested.
+ * @param chars Substring to get characters.
+ * @param len Length of the substring.
+ * @param period Period of the substring (at most 3), or 0 for random
+ *               characters.
+ */
+static void gen_substring(char *chars, const size_t len, const size_t period)
+{
+    if (period == 0) {
+        gen_random_string(chars, len);
+        return;
+    }
+    gen_random_string(chars, period);
+    while (period > 1 && chars[period - 1] == chars[0]) {
+        gen_random_string(chars + period - 1, 1);
+    }
+    for (size_t i = period; i < len; i++) {
+        chars[i] = chars[i - period];
+    }
+    chars[len] = 0;
+}
+
+/**
+ * Plants occurrences of a substring into a string at the given position. A
+ * substring with a period is planted twice, the second occurrence starting
+ * period characters after the first one, so the two overlap.
+ * @param str String to get the substring.
+ * @param len Length of the string.
+ * @param sub Substring to be planted.
+ * @param period Period of the substring, or 0 for random characters.
+ * @param position Position of the first occurrence, which is reduced so
+ *                 that the occurrences fit in the string.
+ * @return Number of planted occurrences, or 0 if they do not fit.
+ */
+static size_t plant_substring(char *str, const size_t len,
+                              const struct Substring *sub,
+                              const size_t period, const size_t position)
+{
+    size_t plant_length = sub->length + period;
+
+    if (plant_length > len) {
+        return 0;
+    }
+    for (size_t i = 0; i < plant_length; i++) {
+        str[position % (len - plant_length + 1) + i] =
+            period ? sub->chars[i % period] : sub->chars[i];
+    }
+    return period ? 2 : 1;
+}
+
+/**
+ * Calculates the failure table of the Knuth-Morris-Pratt algorithm for the
+ * given substring. Entry i is the length of the longest proper prefix of the
+ * first i + 1 characters that is also their suffix.
+ * @param sub Substring whose failure table is to be calculated.
+ */
+static void prepare_substring(struct Substring *sub)
+{
+    size_t k = 0;
+
+    sub->length = strlen(sub->chars);
+    sub->failure[0] = 0;
+    for (size_t i = 1; i < sub->length; i++) {
+        while (k > 0 && sub->chars[i] != sub->chars[k]) {
+            k = sub->failure[k - 1];
+        }
+        if (sub->chars[i] == sub->chars[k]) {
+            k++;
+        }
+        sub->failure[i] = k;
+    }
+}
+
+/**
+ * Counts all (possibly overlapping) occurrences of a substring in a given
+ * string by comparing the substring at every position of the string.
+ * @param str A string to be searched.
+ * @param sub A substring to be found.
+ */
+size_t strfind_naive(const char *str, const struct Substring *sub)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; str[i]; i++) {
+        size_t j = 0;
+
+        while (j < sub->length && str[i + j] == sub->chars[j]) {
+            j++;
+        }
+        if (j == sub->length) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Counts all (possibly overlapping) occurrences of a substring in a given
+ * string. The candidate positions are found with memchr(), which looks for
+ * the first character of the substring, and the rest of the substring is
+ * then compared with memcmp().
+ * @param str A string to be searched.
+ * @param sub A substring to be found.
+ */
+size_t strfind_memchr(const char *str, const struct Substring *sub)
+{
+    const char *end = str + strlen(str);
+    const char *candidate = str;
+    size_t count = 0;
+
+    while (end - candidate >= (ptrdiff_t)sub->length &&
+           (candidate = memchr(candidate, sub->chars[0],
+                               end - candidate - sub->length + 1)) != NULL) {
+        if (!memcmp(candidate + 1, sub->chars + 1, sub->length - 1)) {
+            count++;
+        }
+        candidate++;
+    }
+    return count;
+}
+
+/**
+ * Counts all (possibly overlapping) occurrences of a substring in a given
+ * string using the Knuth-Morris-Pratt algorithm. Each character of the
+ * string is read once, and on a mismatch, the failure table tells how much
+ * of the substring still matches.
+ * @param str A string to be searched.
+ * @param sub A substring (with its failure table) to be found.
+ */
+size_t strfind_kmp(const char *str, const struct Substring *sub)
+{
+    size_t count = 0;
+    size_t k = 0;
+
+    for (size_t i = 0; str[i]; i++) {
+        while (k > 0 && str[i] != sub->chars[k]) {
+            k = sub->failure[k - 1];
+        }
+        if (str[i] == sub->chars[k]) {
+            k++;
+        }
+        if (k == sub->length) {
+            count++;
+            k = sub->failure[k - 1];
+        }
+    }
+    return count;
+}
+
+void main (int argc, char* argv[])
+{
+    char *random_strings;
+    struct Substring substrings[NUMBER_OF_SUBSTRINGS];
+    size_t occurrences[NUMBER_OF_SUBSTRINGS];
+    size_t planted[NUMBER_OF_SUBSTRINGS] = {0};
+    size_t string_length = DEFAULT_STRING_LENGTH;
+    size_t number_of_strings = DEFAULT_NUMBER_OF_STRINGS;
+    size_t buffer_size;
+    int32_t number_of_repetitions = DEFAULT_NUMBER_OF_REPETITIONS;
+    int32_t option;
+    size_t (*strfind)(const char *, const struct Substring *) = strfind_naive;
+
+    /* Parse command line options */
+    while ((option = getopt(argc, argv, "n:k:l:c:")) != -1) {
+        if (option == 'n') {
+            int32_t user_number_of_repetitions = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_number_of_repetitions < 1) {
+                fprintf(stderr, "Error ... Value for option '-n' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_number_of_repetitions == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-n'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_number_of_repetitions > MAX_NUMBER_OF_REPETITIONS) {
+                fprintf(stderr, "Error ... Value for option '-n' cannot be "
+                                "more than %d.\n", MAX_NUMBER_OF_REPETITIONS);
+                exit(EXIT_FAILURE);
+            }
+            number_of_repetitions = user_number_of_repetitions;
+        } else if (option == 'k') {
+            /* Select the kernel used for finding the substrings */
+            if (!strcmp(optarg, "naive")) {
+                strfind = strfind_naive;
+            } else if (!strcmp(optarg, "memchr")) {
+                strfind = strfind_memchr;
+            } else if (!strcmp(optarg, "kmp")) {
+                strfind = strfind_kmp;
+            } else {
+                fprintf(stderr, "Error ... Value for option '-k' must be "
+                                "'naive', 'memchr' or 'kmp'.\n");
+                exit(EXIT_FAILURE);
+            }
+        } else if (option == 'l') {
+            int32_t user_string_length = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_string_length < 1) {
+                fprintf(stderr, "Error ... Value for option '-l' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_string_length == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-l'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_string_length > MAX_STRING_LENGTH) {
+                fprintf(stderr, "Error ... Value for option '-l' cannot be "
+                                "more than %d.\n", MAX_STRING_LENGTH);
+                exit(EXIT_FAILURE);
+            }
+            string_length = user_string_length;
+        } else if (option == 'c') {
+            int32_t user_number_of_strings = atoi(optarg);
+            /* Check if the value is a negative number */
+            if (user_number_of_strings < 1) {
+                fprintf(stderr, "Error ... Value for option '-c' cannot be a "
+                                "negative number.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is a string or zero */
+            if (user_number_of_strings == 0) {
+                fprintf(stderr, "Error ... Invalid value for option '-c'.\n");
+                exit(EXIT_FAILURE);
+            }
+            /* Check if the value is too large */
+            if (user_number_of_strings > MAX_NUMBER_OF_STRINGS) {
+                fprintf(stderr, "Error ... Value for option '-c' cannot be "
+                                "more than %d.\n", MAX_NUMBER_OF_STRINGS);
+                exit(EXIT_FAILURE);
+            }
+            number_of_strings = user_number_of_strings;
+        } else {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Check that the strings fit in the largest supported buffer */
+    if ((uint64_t)(string_length + 1) * number_of_strings > MAX_BUFFER_SIZE) {
+        fprintf(stderr, "Error ... Strings cannot take more than %d bytes.\n",
+                MAX_BUFFER_SIZE);
+        exit(EXIT_FAILURE);
+    }
+    buffer_size = (string_length + 1) * number_of_strings;
+
+    /* Allocate the strings on the heap, one after another */
+    random_strings = malloc(buffer_size);
+    if (random_strings == NULL) {
+        fprintf(stderr, "Error ... Failed to allocate the strings.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * Create an array of substrings with random content. They are created
+     * before the strings, so they are the same for any length and count of
+     * the strings.
+     */
+    srand(1);
+    for (size_t s = 0; s < NUMBER_OF_SUBSTRINGS; s++) {
+        gen_substring(substrings[s].chars, substring_lengths[s],
+                      substring_periods[s]);
+        prepare_substring(&substrings[s]);
+    }
+
+    /*
+     * Create an array of strings with random content, then plant one of the
+     * substrings into each string at a fixed position, so that every
+     * substring has a known minimum number of occurrences.
+     */
+    for (size_t i = 0; i < number_of_strings; i++) {
+        gen_random_string(random_strings + i * (string_length + 1),
+                          string_length);
+    }
+    for (size_t i = 0; i < number_of_strings; i++) {
+        size_t s = i % NUMBER_OF_SUBSTRINGS;
+
+        planted[s] += plant_substring(random_strings + i * (string_length + 1),
+                                      string_length, &substrings[s],
+                                      substring_periods[s],
+                                      3 * (i / NUMBER_OF_SUBSTRINGS));
+    }
+
+    /* Perform finding of a set of substrings multiple times */
+    for (size_t j = 0; j < number_of_repetitions; j++) {
+        memset(occurrences, 0, sizeof(occurrences));
+        /* Do actual finding using the selected kernel */
+        for (size_t i = 0; i < number_of_strings; i++) {
+            for (size_t s = 0; s < NUMBER_OF_SUBSTRINGS; s++) {
+                occurrences[s] +=
+                    strfind(random_strings + i * (string_length + 1),
+                            &substrings[s]);
+            }
+        }
+    }
+
+    /* Check that no planted occurrence was missed by the kernel */
+    for (size_t s = 0; s < NUMBER_OF_SUBSTRINGS; s++) {
+        if (occurrences[s] < planted[s]) {
+            fprintf(stderr, "Error ... Found %zu occurrences of '%s', but "
+                            "%zu were planted.\n", occurrences[s],
+                    substrings[s].chars, planted[s]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Control printing */
+    printf("CONTROL RESULT: (strfind_string)\n");
+    for (size_t i = 0; i < NUMBER_OF_CONTROL_PRINT_ITEMS &&
+                       i < number_of_strings; i++) {
+        printf(" %.*s", CONTROL_PRINT_LENGTH,
+               random_strings + i * (string_length + 1));
+    }
+    printf("\n");
+    for (size_t s = 0; s < NUMBER_OF_SUBSTRINGS; s++) {
+        printf(" %s:%zu", substrings[s].chars, occurrences[s]);
+    }
+    printf("\n");
+
+    free(random_strings);
+}
@@ -4,6 +4,9 @@
 # Set qemu build absolute path and command line arguments for math.c
 QEMU_BUILD="/home/ahmedkrmn/Desktop/GSoC2020/build/qemu-5.1.0/build-gcc"
 ARGS="-i 3000"
+# Maximum number of targets compiled and executed in parallel
+# (set to 1 to measure each target on an otherwise idle host)
+MAX_JOBS=$(nproc)
 TARGET_COMPILERS=(
     # aarch64-linux-gnu-gcc
     # alpha-linux-gnu-gcc
@@ -41,22 +44,37 @@ for TARGET_COMPILER in ${TARGET_COMPILERS[@]}; do
     TARGET_NAMES+=($TARGET_NAME)
 done
 
-# Compile math.c for the selected targets
+# Generate the header of function domains from the domain table
+python generate_function_domains.py
+
+# Wait until fewer than MAX_JOBS background jobs are running
+wait_for_job_slot() {
+    while [ $(jobs -rp | wc -l) -ge $MAX_JOBS ]; do
+        wait -n
+    done
+}
+
+# Compile math.c for the selected targets in parallel
 echo "--------------------STARTING COMPILATION------------------------"
 mkdir executables
 for i in ${!TARGET_COMPILERS[@]}; do
+    wait_for_job_slot
     echo "Compiling for ${TARGET_NAMES[$i]}"
-    ${TARGET_COMPILERS[$i]} -O2 -static math.c -lm -o executables/math-${TARGET_NAMES[$i]}
+    ${TARGET_COMPILERS[$i]} -O2 -static math.c -lm -o executables/math-${TARGET_NAMES[$i]} &
 done
+wait
 
-# Execute all selected targets
+# Execute all selected targets in parallel
+# Each target writes its results to its own JSON file
 echo "---------------------STARTING EXECUTION-------------------------"
 mkdir output
 for TARGET_NAME in ${TARGET_NAMES[@]}; do
+    wait_for_job_slot
     echo "Executing for $TARGET_NAME"
     $QEMU_BUILD/$TARGET_NAME-linux-user/qemu-$TARGET_NAME executables/math-$TARGET_NAME \
-        $ARGS >output/math-results-$TARGET_NAME.txt
+        $ARGS -o json >output/math-results-$TARGET_NAME.json &
 done
+wait
 echo "----------------------------------------------------------------"
 
 # Call data extraction script
@@ -1,3 +1,4 @@
+import json
 from os import listdir
 from collections import OrderedDict
 from xlutils.copy import copy
@@ -6,29 +7,40 @@ from xlwt import easyxf
 
 ########################## READING TARGETS DATA ##########################
 
+# Statistics printed by math.c for each function (ns per call), and their
+# keys in the JSON output of math.c
+STATISTICS = ['Median', 'Min', 'Stddev']
+STATISTIC_KEYS = ['median', 'min', 'stddev']
+
 # Declare data ordered dictionary to store the extracted data
-data = OrderedDict()
+# For each statistic, it maps each target name to its function results
+data = OrderedDict((statistic, OrderedDict()) for statistic in STATISTICS)
+
+# Declare ordered dictionary to store all results of each target as they
+# were printed by math.c
+results = OrderedDict()
 
 # Read all output file locations produced by running benchmark.sh
+# Each file contains the JSON array of results of a single target
 output_files = sorted(listdir('output'))
 
 # Loop on all output files (targets)
 for output_file in output_files:
     with open('output/' + output_file, 'r') as file:
+        target_results = json.load(file)
 
-        # Create a new ordered dictionary for the data in the target output
-        target_data = OrderedDict()
-
-        for line in file:
-            line_data = line.split()
-
-            # Extract and add function name and estimated time
-            # Double check that the line is valid
-            if(len(line_data) == 11):
-                target_data[(line_data[3])[:-3]] = line_data[6]
+    # Create a new ordered dictionary for each statistic of the target
+    target_name = output_file.split('-')[-1].split('.')[0]
+    for statistic in STATISTICS:
+        data[statistic][target_name] = OrderedDict()
+    results[target_name] = target_results
 
-        # Add target name and target_data
-        data[output_file.split('-')[-1].split('.')[0]] = target_data
+    # Add function name, input range, mode and time statistics
+    for result in target_results:
+        function_name = '{} [{}, {}]'.format(result['function'],
+                                             result['range'], result['mode'])
+        for (statistic, key) in zip(STATISTICS, STATISTIC_KEYS):
+            data[statistic][target_name][function_name] = result[key]
 
 ##########################################################################
 
@@ -38,43 +50,59 @@ for output_file in output_files:
 domains = open_workbook('function_domains.xls', formatting_info=True)
 book = copy(domains)
 
-# Add a new sheet for measurement results
-measurements_sheet = book.add_sheet('measurements')
-
-# Set measurements_sheet as default
-book.active_sheet = 1
-
-# Freeze the header row and column
-measurements_sheet.set_panes_frozen(True)
-measurements_sheet.set_horz_split_pos(1)
-measurements_sheet.set_vert_split_pos(1)
-
 # Bold font style
 bold_style = easyxf('font: bold on')
 
-# Loop the data ordered dictionary
-for (target_index, (target_name, target_data)) in \
-        enumerate(data.items()):
+# Add a new sheet for each statistic of the measurement results
+# The median per call is stored in the "measurements" sheet
+for statistic in STATISTICS:
+    if statistic == 'Median':
+        measurements_sheet = book.add_sheet('measurements')
+    else:
+        measurements_sheet = book.add_sheet(statistic.lower())
+
+    # Freeze the header row and column
+    measurements_sheet.set_panes_frozen(True)
+    measurements_sheet.set_horz_split_pos(1)
+    measurements_sheet.set_vert_split_pos(1)
+
+    # Loop the data ordered dictionary
+    # Each function and input range gets a row (there are more of them than
+    # the 256 columns supported by the spreadsheet format)
+    for (target_index, (target_name, target_data)) in \
+            enumerate(data[statistic].items()):
+
+        # Write the target name to the first row of the measurements_sheet
+        measurements_sheet.write(
+            0, target_index + 1, target_name, bold_style)
 
-    # Write the target name to the measurements_sheet
-    measurements_sheet.write(
-        target_index + 1, 0, target_name, bold_style)
+        # Loop the target data
+        for (function_index, (function_name, function_value)) in \
+                enumerate(target_data.items()):
 
-    # Loop the target data
-    for (function_index, (function_name, function_value)) in \
-            enumerate(target_data.items()):
+            # If this is the fist target,
+            # write the function names to the first column of the sheet
+            if target_index == 0:
+                measurements_sheet.write(
+                    function_index + 1, 0, function_name, bold_style)
 
-        # If this is the fist target,
-        # write the function names to the first row of the measurements_sheet
-        if target_index == 0:
+            # Write the target function time per call (ns) to the sheet
             measurements_sheet.write(
-                0, function_index + 1, function_name, bold_style)
+                function_index + 1, target_index + 1, function_value)
 
-        # Write the target function estimated times to the measurements_sheet
-        measurements_sheet.write(
-            target_index + 1, function_index + 1, function_value)
+# Set the "measurements" sheet as default
+book.active_sheet = 1
 
 # Save spreadsheet
 book.save('math-measurements.ods')
 
 ##########################################################################
+
+########################### SAVING DATA TO JSON ##########################
+
+# Save the results of all targets in a single JSON file
+with open('math-measurements.json', 'w') as file:
+    json.dump(results, file, indent=2)
+    file.write('\n')
+
+##########################################################################
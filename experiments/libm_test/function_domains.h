@@ -0,0 +1,443 @@
+/*
+ *  Domains of the libm functions measured by math.c.
+ *
+ *  This file was generated by generate_function_domains.py from
+ *  function_domains.csv, do not edit it manually.
+ */
+
+#ifndef FUNCTION_DOMAINS_H
+#define FUNCTION_DOMAINS_H
+
+#include <float.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Input range of a libm function. The bounds of the first and second
+ * arguments are stored as {low1, high1, low2, high2} for each FP type.
+ */
+struct FunctionDomain {
+    const char* function;
+    const char* range;
+    bool log_scale;
+    float f_bounds[4];
+    double d_bounds[4];
+    long double l_bounds[4];
+};
+
+static const char* const function_ranges[] = {
+    "normal",
+    "tiny",
+    "huge",
+    "near-singular",
+};
+
+static const struct FunctionDomain function_domains[] = {
+    {"sqrt", "normal", false,
+     {0, 100, 0, 0},
+     {0, 100, 0, 0},
+     {0, 100, 0, 0}},
+    {"sqrt", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"sqrt", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"cbrt", "normal", false,
+     {-100, 100, 0, 0},
+     {-100, 100, 0, 0},
+     {-100, 100, 0, 0}},
+    {"cbrt", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"cbrt", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"hypot", "normal", false,
+     {-100, 100, -100, 100},
+     {-100, 100, -100, 100},
+     {-100, 100, -100, 100}},
+    {"hypot", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, FLT_TRUE_MIN, FLT_MIN},
+     {DBL_TRUE_MIN, DBL_MIN, DBL_TRUE_MIN, DBL_MIN},
+     {LDBL_TRUE_MIN, LDBL_MIN, LDBL_TRUE_MIN, LDBL_MIN}},
+    {"hypot", "huge", true,
+     {1e30, FLT_MAX/2, 1e30, FLT_MAX/2},
+     {1e30, DBL_MAX/2, 1e30, DBL_MAX/2},
+     {1e30, LDBL_MAX/2, 1e30, LDBL_MAX/2}},
+    {"pow", "normal", false,
+     {0, 10, -10, 10},
+     {0, 10, -10, 10},
+     {0, 10, -10, 10}},
+    {"pow", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0.25, 1},
+     {DBL_TRUE_MIN, DBL_MIN, 0.25, 1},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0.25, 1}},
+    {"pow", "huge", true,
+     {1e3, 1e6, 1, 6},
+     {1e3, 1e6, 1, 6},
+     {1e3, 1e6, 1, 6}},
+    {"pow", "near-singular", false,
+     {0.9999, 1.0001, 1e3, 1e5},
+     {0.9999, 1.0001, 1e3, 1e5},
+     {0.9999, 1.0001, 1e3, 1e5}},
+    {"exp", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"exp", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"exp", "huge", false,
+     {0.9*0.6931471805599453*(FLT_MAX_EXP-1), 0.6931471805599453*(FLT_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(DBL_MAX_EXP-1), 0.6931471805599453*(DBL_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(LDBL_MAX_EXP-1), 0.6931471805599453*(LDBL_MAX_EXP-1), 0, 0}},
+    {"exp", "near-singular", false,
+     {0.6931471805599453*(FLT_MIN_EXP-FLT_MANT_DIG), 0.6931471805599453*(FLT_MIN_EXP-1), 0, 0},
+     {0.6931471805599453*(DBL_MIN_EXP-DBL_MANT_DIG), 0.6931471805599453*(DBL_MIN_EXP-1), 0, 0},
+     {0.6931471805599453*(LDBL_MIN_EXP-LDBL_MANT_DIG), 0.6931471805599453*(LDBL_MIN_EXP-1), 0, 0}},
+    {"exp2", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"exp2", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"exp2", "huge", false,
+     {0.9*(FLT_MAX_EXP-1), FLT_MAX_EXP-1, 0, 0},
+     {0.9*(DBL_MAX_EXP-1), DBL_MAX_EXP-1, 0, 0},
+     {0.9*(LDBL_MAX_EXP-1), LDBL_MAX_EXP-1, 0, 0}},
+    {"exp2", "near-singular", false,
+     {FLT_MIN_EXP-FLT_MANT_DIG, FLT_MIN_EXP-1, 0, 0},
+     {DBL_MIN_EXP-DBL_MANT_DIG, DBL_MIN_EXP-1, 0, 0},
+     {LDBL_MIN_EXP-LDBL_MANT_DIG, LDBL_MIN_EXP-1, 0, 0}},
+    {"expm1", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"expm1", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"expm1", "huge", false,
+     {0.9*0.6931471805599453*(FLT_MAX_EXP-1), 0.6931471805599453*(FLT_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(DBL_MAX_EXP-1), 0.6931471805599453*(DBL_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(LDBL_MAX_EXP-1), 0.6931471805599453*(LDBL_MAX_EXP-1), 0, 0}},
+    {"log", "normal", false,
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0}},
+    {"log", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"log", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"log", "near-singular", false,
+     {0.9999, 1.0001, 0, 0},
+     {0.9999, 1.0001, 0, 0},
+     {0.9999, 1.0001, 0, 0}},
+    {"log2", "normal", false,
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0}},
+    {"log2", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"log2", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"log2", "near-singular", false,
+     {0.9999, 1.0001, 0, 0},
+     {0.9999, 1.0001, 0, 0},
+     {0.9999, 1.0001, 0, 0}},
+    {"log10", "normal", false,
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0}},
+    {"log10", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"log10", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"log10", "near-singular", false,
+     {0.9999, 1.0001, 0, 0},
+     {0.9999, 1.0001, 0, 0},
+     {0.9999, 1.0001, 0, 0}},
+    {"log1p", "normal", false,
+     {-0.99, 100, 0, 0},
+     {-0.99, 100, 0, 0},
+     {-0.99, 100, 0, 0}},
+    {"log1p", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"log1p", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"log1p", "near-singular", false,
+     {-0.9999, -0.99, 0, 0},
+     {-0.9999, -0.99, 0, 0},
+     {-0.9999, -0.99, 0, 0}},
+    {"ilogb", "normal", false,
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0}},
+    {"ilogb", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"ilogb", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"logb", "normal", false,
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0},
+     {0.001, 100, 0, 0}},
+    {"logb", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"logb", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"sin", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"sin", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"sin", "huge", true,
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0}},
+    {"cos", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"cos", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"cos", "huge", true,
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0}},
+    {"tan", "normal", false,
+     {-1.5, 1.5, 0, 0},
+     {-1.5, 1.5, 0, 0},
+     {-1.5, 1.5, 0, 0}},
+    {"tan", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"tan", "huge", true,
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0}},
+    {"tan", "near-singular", false,
+     {1.5707, 1.5709, 0, 0},
+     {1.5707, 1.5709, 0, 0},
+     {1.5707, 1.5709, 0, 0}},
+    {"asin", "normal", false,
+     {-1, 1, 0, 0},
+     {-1, 1, 0, 0},
+     {-1, 1, 0, 0}},
+    {"asin", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"asin", "near-singular", false,
+     {0.9999, 1, 0, 0},
+     {0.9999, 1, 0, 0},
+     {0.9999, 1, 0, 0}},
+    {"acos", "normal", false,
+     {-1, 1, 0, 0},
+     {-1, 1, 0, 0},
+     {-1, 1, 0, 0}},
+    {"acos", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"acos", "near-singular", false,
+     {0.9999, 1, 0, 0},
+     {0.9999, 1, 0, 0},
+     {0.9999, 1, 0, 0}},
+    {"atan", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"atan", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"atan", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"atan2", "normal", false,
+     {-10, 10, -10, 10},
+     {-10, 10, -10, 10},
+     {-10, 10, -10, 10}},
+    {"atan2", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, FLT_TRUE_MIN, FLT_MIN},
+     {DBL_TRUE_MIN, DBL_MIN, DBL_TRUE_MIN, DBL_MIN},
+     {LDBL_TRUE_MIN, LDBL_MIN, LDBL_TRUE_MIN, LDBL_MIN}},
+    {"atan2", "huge", true,
+     {1e30, FLT_MAX, 1e30, FLT_MAX},
+     {1e30, DBL_MAX, 1e30, DBL_MAX},
+     {1e30, LDBL_MAX, 1e30, LDBL_MAX}},
+    {"sinh", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"sinh", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"sinh", "huge", false,
+     {0.9*0.6931471805599453*(FLT_MAX_EXP-1), 0.6931471805599453*(FLT_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(DBL_MAX_EXP-1), 0.6931471805599453*(DBL_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(LDBL_MAX_EXP-1), 0.6931471805599453*(LDBL_MAX_EXP-1), 0, 0}},
+    {"cosh", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"cosh", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"cosh", "huge", false,
+     {0.9*0.6931471805599453*(FLT_MAX_EXP-1), 0.6931471805599453*(FLT_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(DBL_MAX_EXP-1), 0.6931471805599453*(DBL_MAX_EXP-1), 0, 0},
+     {0.9*0.6931471805599453*(LDBL_MAX_EXP-1), 0.6931471805599453*(LDBL_MAX_EXP-1), 0, 0}},
+    {"tanh", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"tanh", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"tanh", "huge", true,
+     {20, 1e30, 0, 0},
+     {20, 1e30, 0, 0},
+     {20, 1e30, 0, 0}},
+    {"asinh", "normal", false,
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0},
+     {-10, 10, 0, 0}},
+    {"asinh", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"asinh", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"acosh", "normal", false,
+     {1, 100, 0, 0},
+     {1, 100, 0, 0},
+     {1, 100, 0, 0}},
+    {"acosh", "huge", true,
+     {1e30, FLT_MAX, 0, 0},
+     {1e30, DBL_MAX, 0, 0},
+     {1e30, LDBL_MAX, 0, 0}},
+    {"acosh", "near-singular", false,
+     {1, 1.0001, 0, 0},
+     {1, 1.0001, 0, 0},
+     {1, 1.0001, 0, 0}},
+    {"atanh", "normal", false,
+     {-0.99, 0.99, 0, 0},
+     {-0.99, 0.99, 0, 0},
+     {-0.99, 0.99, 0, 0}},
+    {"atanh", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"atanh", "near-singular", false,
+     {0.9999, 1, 0, 0},
+     {0.9999, 1, 0, 0},
+     {0.9999, 1, 0, 0}},
+    {"erf", "normal", false,
+     {-5, 5, 0, 0},
+     {-5, 5, 0, 0},
+     {-5, 5, 0, 0}},
+    {"erf", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"erf", "huge", true,
+     {10, 1e30, 0, 0},
+     {10, 1e30, 0, 0},
+     {10, 1e30, 0, 0}},
+    {"erfc", "normal", false,
+     {-5, 5, 0, 0},
+     {-5, 5, 0, 0},
+     {-5, 5, 0, 0}},
+    {"erfc", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"erfc", "huge", true,
+     {10, 1e30, 0, 0},
+     {10, 1e30, 0, 0},
+     {10, 1e30, 0, 0}},
+    {"lgamma", "normal", false,
+     {0.5, 20, 0, 0},
+     {0.5, 20, 0, 0},
+     {0.5, 20, 0, 0}},
+    {"lgamma", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"lgamma", "huge", true,
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0},
+     {1e6, 1e30, 0, 0}},
+    {"lgamma", "near-singular", false,
+     {-2.0001, -1.9999, 0, 0},
+     {-2.0001, -1.9999, 0, 0},
+     {-2.0001, -1.9999, 0, 0}},
+    {"tgamma", "normal", false,
+     {0.5, 20, 0, 0},
+     {0.5, 20, 0, 0},
+     {0.5, 20, 0, 0}},
+    {"tgamma", "tiny", true,
+     {FLT_TRUE_MIN, FLT_MIN, 0, 0},
+     {DBL_TRUE_MIN, DBL_MIN, 0, 0},
+     {LDBL_TRUE_MIN, LDBL_MIN, 0, 0}},
+    {"tgamma", "huge", false,
+     {20, 34, 0, 0},
+     {20, 34, 0, 0},
+     {20, 34, 0, 0}},
+    {"tgamma", "near-singular", false,
+     {-1.0001, -0.9999, 0, 0},
+     {-1.0001, -0.9999, 0, 0},
+     {-1.0001, -0.9999, 0, 0}},
+};
+
+#define NUMBER_OF_FUNCTION_RANGES \
+    (sizeof(function_ranges) / sizeof(function_ranges[0]))
+#define NUMBER_OF_FUNCTION_DOMAINS \
+    (sizeof(function_domains) / sizeof(function_domains[0]))
+
+#endif
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+
+"""
+Generate the C header "function_domains.h" used by math.c from the
+machine-readable domain table "function_domains.csv".
+
+Each row of the table describes the input range of a libm function for one
+class of inputs (normal, tiny, huge or near-singular). The bounds may use the
+symbolic names of the characteristics of the floating point type (MIN,
+TRUE_MIN, MAX, EPSILON, MANT_DIG, MIN_EXP and MAX_EXP) as well as LN2. They
+are expanded into the "FLT_", "DBL_" and "LDBL_" constants of <float.h>, so
+one row covers the 'float', 'double' and 'long double' version of the
+function on every target.
+
+This file is a part of the project "TCG Continuous Benchmarking".
+
+Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/>.
+"""
+
+import argparse
+import csv
+import re
+import sys
+
+
+# Supported input ranges in the order they are measured
+RANGES = ['normal', 'tiny', 'huge', 'near-singular']
+
+# Supported scales of the random inputs inside a range
+SCALES = ['linear', 'log']
+
+# Symbolic names of floating point characteristics and their <float.h> prefix
+FLOAT_CHARACTERISTICS = ['TRUE_MIN', 'MIN', 'MAX', 'EPSILON', 'MANT_DIG',
+                         'MIN_EXP', 'MAX_EXP']
+FLOAT_PREFIXES = ['FLT_', 'DBL_', 'LDBL_']
+
+# Natural logarithm of 2
+LN2 = '0.6931471805599453'
+
+# Characters allowed in a bound expression after expanding the symbolic names
+BOUND_PATTERN = re.compile(r'^[0-9A-Za-z_.+\-*/() ]+$')
+
+
+def expand_bound(bound, prefix):
+    """
+    Expand the symbolic names used in a bound into a C expression.
+
+    Parameters:
+    bound (str): Bound as written in the domain table
+    prefix (str): Prefix of the <float.h> constants of the FP type
+
+    Returns:
+    (str): C expression of the bound
+    """
+    if not BOUND_PATTERN.match(bound):
+        raise ValueError('Invalid bound "{}"'.format(bound))
+    expression = re.sub(r'\b({})\b'.format('|'.join(FLOAT_CHARACTERISTICS)),
+                        lambda match: prefix + match.group(1), bound)
+    expression = re.sub(r'\bLN2\b', LN2, expression)
+    identifiers = re.findall(r'\b[A-Za-z_]\w*\b', expression)
+    for identifier in identifiers:
+        if not identifier.startswith(prefix):
+            raise ValueError('Unknown name "{}" in bound "{}"'.format(
+                identifier, bound))
+    return expression
+
+
+def read_domain_table(table_path):
+    """
+    Read and validate the rows of the domain table.
+
+    Parameters:
+    table_path (str): Path of the CSV domain table
+
+    Returns:
+    (list): List of dictionaries, one for each row of the table
+    """
+    domains = []
+    with open(table_path, 'r') as table:
+        for (line_number, row) in enumerate(csv.DictReader(table), start=2):
+            location = '{}:{}'.format(table_path, line_number)
+            if row['range'] not in RANGES:
+                raise ValueError('{}: Unknown range "{}"'.format(
+                    location, row['range']))
+            if row['scale'] not in SCALES:
+                raise ValueError('{}: Unknown scale "{}"'.format(
+                    location, row['scale']))
+            if not row['low1'] or not row['high1'] or \
+                    bool(row['low2']) != bool(row['high2']):
+                raise ValueError('{}: Missing bounds'.format(location))
+            domains.append(row)
+    return domains
+
+
+def write_header(domains, header_path):
+    """
+    Write the C header containing the domain table.
+
+    Parameters:
+    domains (list): Rows of the domain table
+    header_path (str): Path of the generated header
+    """
+    with open(header_path, 'w') as header:
+        header.write(
+            '/*\n'
+            ' *  Domains of the libm functions measured by math.c.\n'
+            ' *\n'
+            ' *  This file was generated by generate_function_domains.py '
+            'from\n'
+            ' *  function_domains.csv, do not edit it manually.\n'
+            ' */\n\n'
+            '#ifndef FUNCTION_DOMAINS_H\n'
+            '#define FUNCTION_DOMAINS_H\n\n'
+            '#include <float.h>\n'
+            '#include <stdbool.h>\n'
+            '#include <stddef.h>\n\n'
+            '/**\n'
+            ' * Input range of a libm function. The bounds of the first and '
+            'second\n'
+            ' * arguments are stored as {low1, high1, low2, high2} for each '
+            'FP type.\n'
+            ' */\n'
+            'struct FunctionDomain {\n'
+            '    const char* function;\n'
+            '    const char* range;\n'
+            '    bool log_scale;\n'
+            '    float f_bounds[4];\n'
+            '    double d_bounds[4];\n'
+            '    long double l_bounds[4];\n'
+            '};\n\n')
+
+        header.write('static const char* const function_ranges[] = {\n')
+        for range_name in RANGES:
+            header.write('    "{}",\n'.format(range_name))
+        header.write('};\n\n')
+
+        header.write(
+            'static const struct FunctionDomain function_domains[] = {\n')
+        for domain in domains:
+            header.write('    {{"{}", "{}", {},\n'.format(
+                domain['function'], domain['range'],
+                'true' if domain['scale'] == 'log' else 'false'))
+            bounds = []
+            for prefix in FLOAT_PREFIXES:
+                expressions = [expand_bound(domain[name] or '0', prefix)
+                               for name in ['low1', 'high1', 'low2', 'high2']]
+                bounds.append('     {{{}}}'.format(', '.join(expressions)))
+            header.write(',\n'.join(bounds) + '},\n')
+        header.write('};\n\n')
+
+        header.write(
+            '#define NUMBER_OF_FUNCTION_RANGES \\\n'
+            '    (sizeof(function_ranges) / sizeof(function_ranges[0]))\n'
+            '#define NUMBER_OF_FUNCTION_DOMAINS \\\n'
+            '    (sizeof(function_domains) / sizeof(function_domains[0]))\n\n'
+            '#endif\n')
+
+
+def main():
+    """
+    Parse the command line arguments then generate the header.
+    """
+    parser = argparse.ArgumentParser(
+        description='Generate function_domains.h from function_domains.csv')
+    parser.add_argument('-i', dest='table_path', type=str,
+                        default='function_domains.csv',
+                        help='Path of the CSV domain table')
+    parser.add_argument('-o', dest='header_path', type=str,
+                        default='function_domains.h',
+                        help='Path of the generated header')
+    args = parser.parse_args()
+
+    try:
+        domains = read_domain_table(args.table_path)
+        write_header(domains, args.header_path)
+    except ValueError as error:
+        sys.exit('Error ... {}'.format(error))
+
+
+if __name__ == '__main__':
+    main()
@@ -30,36 +30,83 @@
 #include <time.h>
 #include <unistd.h>
 
-#define RANDOM_DATA_LEN 100
+#include "function_domains.h"
+#include "vector_math.h"
+
+/* Number of random inputs (and results) of each function */
+#define DEFAULT_RANDOM_DATA_LEN 100
+#define MAX_RANDOM_DATA_LEN 1000000
 
 /**
- * Arrays for storing random inputs. For now, only random inputs between
- * 0.0 and 1.0 are supported. There are two separate sets of inputs for each
- * floating point type: 'float', 'double' and 'long double'.
+ * Size of the buffer for the formatted control result, enough for the
+ * largest 'long double' value printed with "%Lf".
  */
-static float f_rnd1_0_to_1[RANDOM_DATA_LEN];
-static float f_rnd2_0_to_1[RANDOM_DATA_LEN];
-static double d_rnd1_0_to_1[RANDOM_DATA_LEN];
-static double d_rnd2_0_to_1[RANDOM_DATA_LEN];
-static long double l_rnd1_0_to_1[RANDOM_DATA_LEN];
-static long double l_rnd2_0_to_1[RANDOM_DATA_LEN];
+#define CONTROL_RESULT_LEN 5120
+
+/* Number of timed samples of each function */
+#define DEFAULT_NUMBER_OF_SAMPLES 5
+#define MAX_NUMBER_OF_SAMPLES 1000
+
+/**
+ * Length of the arrays of random inputs and results. It can be changed with
+ * the '-l' flag to control how much of the data stays in the caches.
+ */
+static size_t random_data_len = DEFAULT_RANDOM_DATA_LEN;
+
+/**
+ * Arrays for storing random inputs. They are generated for each function and
+ * each of its input ranges from the domains in "function_domains.h". There
+ * are two separate sets of inputs (one per argument) for each floating point
+ * type: 'float', 'double' and 'long double'.
+ */
+static float* f_rnd1;
+static float* f_rnd2;
+static double* d_rnd1;
+static double* d_rnd2;
+static long double* l_rnd1;
+static long double* l_rnd2;
 
 /**
  * Arrays for storing results. They can be of type 'int' (the only functions
  * where this is the case are ilogbl(), ilogb(), and ilogbl()), 'float',
  * 'double' and 'long double'.
  */
-static int i_result[RANDOM_DATA_LEN];
-static float f_result[RANDOM_DATA_LEN];
-static double d_result[RANDOM_DATA_LEN];
-static long double l_result[RANDOM_DATA_LEN];
+static int* i_result;
+static float* f_result;
+static double* d_result;
+static long double* l_result;
+
+/**
+ * Mask used in the latency mode for making the input index of each call
+ * depend on the result of the previous call. It is always zero, but it is
+ * volatile so the compiler can't remove the dependency.
+ */
+static volatile unsigned char chain_mask = 0;
+
+/**
+ * Output formats of the results: a line of text, a CSV row, or a JSON object
+ * (an element of a JSON array) for each function and input range.
+ */
+enum OutputFormat { OUTPUT_TEXT, OUTPUT_CSV, OUTPUT_JSON };
+
+/* Output format selected with the '-o' flag */
+static enum OutputFormat output_format = OUTPUT_TEXT;
+
+/* Number of results printed so far */
+static size_t number_of_results = 0;
 
 /**
- * Utility function for calculating elapsed time (ms) as a difference between
+ * Array for storing the elapsed time (ns) of each timed sample of the
+ * function that is currently being measured.
+ */
+static uint64_t sample_times[MAX_NUMBER_OF_SAMPLES];
+
+/**
+ * Utility function for calculating elapsed time (ns) as a difference between
  * times derived from two 'timespec' objects.
  */
-static int64_t get_elapsed_time(struct timespec* time_start,
-                                struct timespec* time_stop) {
+static uint64_t get_elapsed_time(struct timespec* time_start,
+                                 struct timespec* time_stop) {
     struct timespec time_diff;
     uint64_t elapsed_time;
 
@@ -71,85 +118,246 @@ static int64_t get_elapsed_time(struct timespec* time_start,
         time_diff.tv_sec = time_stop->tv_sec - time_start->tv_sec;
         time_diff.tv_nsec = time_stop->tv_nsec - time_start->tv_nsec;
     }
-    elapsed_time = time_diff.tv_sec * 1000 +
-                   time_diff.tv_nsec / 1000000;
+    elapsed_time = (uint64_t)time_diff.tv_sec * 1000000000 +
+                   time_diff.tv_nsec;
 
     return elapsed_time;
 }
 
 /**
- * Macros for creating wrappers for measuring elapsed time for libm math
- * functions whose base floating point type is 'float'.
+ * Utility function for generating a random input between 'low' and 'high'.
+ * The inputs are uniformly distributed either on a linear or on a logarithmic
+ * scale. The latter is used for ranges spanning many orders of magnitude.
+ */
+static long double generate_random_input(long double low, long double high,
+                                         bool log_scale) {
+    long double u = (long double)rand() / (long double)RAND_MAX;
+    long double input;
+
+    if (low == high) {
+        return low;
+    }
+    if (log_scale) {
+        input = low * powl(high / low, u);
+    } else {
+        input = low + (high - low) * u;
+    }
+    /* Keep rounding errors from moving the input outside of the range */
+    return input < low ? low : input > high ? high : input;
+}
+
+/**
+ * Utility function for generating the random inputs of the floating point
+ * type 'type' ('f', 'd' or 'l') in a given function domain. The generator is
+ * reseeded, so each range always gets the same inputs.
+ */
+static void generate_inputs(const struct FunctionDomain* domain, char type) {
+    srand(1);
+    for (size_t i = 0; i < random_data_len; ++i) {
+        if (type == 'f') {
+            f_rnd1[i] = generate_random_input(domain->f_bounds[0],
+                                              domain->f_bounds[1],
+                                              domain->log_scale);
+            f_rnd2[i] = generate_random_input(domain->f_bounds[2],
+                                              domain->f_bounds[3],
+                                              domain->log_scale);
+        } else if (type == 'd') {
+            d_rnd1[i] = generate_random_input(domain->d_bounds[0],
+                                              domain->d_bounds[1],
+                                              domain->log_scale);
+            d_rnd2[i] = generate_random_input(domain->d_bounds[2],
+                                              domain->d_bounds[3],
+                                              domain->log_scale);
+        } else {
+            l_rnd1[i] = generate_random_input(domain->l_bounds[0],
+                                              domain->l_bounds[1],
+                                              domain->log_scale);
+            l_rnd2[i] = generate_random_input(domain->l_bounds[2],
+                                              domain->l_bounds[3],
+                                              domain->log_scale);
+        }
+    }
+}
+
+/**
+ * Utility function for checking whether a function domain belongs to the
+ * libm function 'function_name' of the floating point type 'type' ('f', 'd'
+ * or 'l') and to the selected range (NULL selects all ranges). The domains
+ * are named after the 'double' functions, so the 'f' and 'l' suffixes of
+ * the other types are ignored.
+ */
+static bool is_selected_domain(const struct FunctionDomain* domain,
+                               const char* function_name, char type,
+                               const char* selected_range) {
+    size_t name_length = strlen(domain->function);
+
+    if (strlen(function_name) != name_length + (type != 'd') ||
+        strncmp(function_name, domain->function, name_length)) {
+        return false;
+    }
+    return selected_range == NULL || !strcmp(selected_range, domain->range);
+}
+
+/**
+ * Comparison function of two sample times for qsort().
+ */
+static int compare_sample_times(const void* a, const void* b) {
+    uint64_t time_a = *(const uint64_t*)a;
+    uint64_t time_b = *(const uint64_t*)b;
+
+    return (time_a > time_b) - (time_a < time_b);
+}
+
+/**
+ * Utility function for sorting the timed samples and calculating their
+ * median time (ns).
+ */
+static double get_median_time(int32_t k) {
+    qsort(sample_times, k, sizeof(uint64_t), compare_sample_times);
+    return k % 2 ? sample_times[k / 2]
+                 : (sample_times[k / 2 - 1] + sample_times[k / 2]) / 2.0;
+}
+
+/**
+ * Utility function for printing the result of measuring a function on an
+ * input range in the selected output format. The median, minimum and
+ * standard deviation of the time (ns) per function call are calculated over
+ * all timed samples. Each sample consists of 'n' iterations of
+ * 'random_data_len' function calls. The speedup over the scalar function is
+ * only printed when 'implementation' is not NULL (in the vector mode).
  */
-#define TEST_MATH_FUNCTION_F_F(FNAME)                            \
-    void test_loop_##FNAME(int32_t n) {                          \
-        struct timespec time_start, time_end;                    \
-        uint64_t elapsed_time;                                   \
-                                                                 \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);         \
-        printf("* Profiling function %s():\t", #FNAME);          \
-        for (size_t i = 0; i < n; ++i) {                         \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {       \
-                f_result[j] = FNAME(f_rnd1_0_to_1[j]);           \
-            }                                                    \
-        }                                                        \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);           \
-                                                                 \
-        elapsed_time = get_elapsed_time(&time_start, &time_end); \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);  \
-                                                                 \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {           \
-            f_result[0] += f_result[i];                          \
-        }                                                        \
-        printf("Control result: %f\n", f_result[0]);             \
+static void print_result(const char* function, const char* range,
+                         const char* mode, int32_t n, int32_t k,
+                         double speedup, const char* implementation,
+                         const char* control_result) {
+    double calls_per_sample = (double)n * random_data_len;
+    double median, minimum, stddev, mean = 0, variance = 0;
+
+    median = get_median_time(k) / calls_per_sample;
+    minimum = sample_times[0] / calls_per_sample;
+    for (int32_t s = 0; s < k; ++s) {
+        mean += sample_times[s];
+    }
+    mean /= k;
+    for (int32_t s = 0; s < k; ++s) {
+        variance += (sample_times[s] - mean) * (sample_times[s] - mean);
     }
+    variance = k > 1 ? variance / (k - 1) : 0;
+    stddev = sqrt(variance) / calls_per_sample;
 
-#define TEST_MATH_FUNCTION_I_F(FNAME)                            \
-    void test_loop_##FNAME(int32_t n) {                          \
-        struct timespec time_start, time_end;                    \
-        uint64_t elapsed_time;                                   \
-                                                                 \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);         \
-        printf("* Profiling function %s():\t", #FNAME);          \
-        for (size_t i = 0; i < n; ++i) {                         \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {       \
-                i_result[j] = FNAME(f_rnd1_0_to_1[j]);           \
-            }                                                    \
-        }                                                        \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);           \
-                                                                 \
-        elapsed_time = get_elapsed_time(&time_start, &time_end); \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);  \
-                                                                 \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {           \
-            i_result[0] += i_result[i];                          \
-        }                                                        \
-        printf("Control result: %d\n", i_result[0]);             \
+    if (output_format == OUTPUT_CSV) {
+        printf("%s,%s,%s,%.3f,%.3f,%.3f,%" PRId32 ",", function, range, mode,
+               median, minimum, stddev, k);
+        if (implementation != NULL) {
+            printf("%.3f,%s,", speedup, implementation);
+        } else {
+            printf(",,");
+        }
+        printf("%s\n", control_result);
+    } else if (output_format == OUTPUT_JSON) {
+        printf("%s  {\"function\": \"%s\", \"range\": \"%s\", \"mode\": \"%s\", "
+               "\"median\": %.3f, \"min\": %.3f, \"stddev\": %.3f, "
+               "\"samples\": %" PRId32 ", ",
+               number_of_results ? ",\n" : "", function, range, mode, median,
+               minimum, stddev, k);
+        if (implementation != NULL) {
+            printf("\"speedup\": %.3f, \"implementation\": \"%s\", ", speedup,
+                   implementation);
+        }
+        printf("\"control_result\": \"%s\"}", control_result);
+    } else {
+        printf("* Profiling function %s() [%s, %s]:\t", function, range, mode);
+        printf("Median: %.3f ns/call\tMin: %.3f ns/call\tStddev: %.3f ns/call\t"
+               "Samples: %" PRId32 "\t",
+               median, minimum, stddev, k);
+        if (implementation != NULL) {
+            printf("Speedup: %.3f\tImplementation: %s\t", speedup,
+                   implementation);
+        }
+        printf("Control result: %s\n", control_result);
     }
+    number_of_results++;
+}
 
-#define TEST_MATH_FUNCTION_F_FF(FNAME)                                   \
-    void test_loop_##FNAME(int32_t n) {                                  \
-        struct timespec time_start, time_end;                            \
-        uint64_t elapsed_time;                                           \
-                                                                         \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);                 \
-        printf("* Profiling function %s():\t", #FNAME);                  \
-        for (size_t i = 0; i < n; ++i) {                                 \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {               \
-                f_result[j] = FNAME(f_rnd1_0_to_1[j], f_rnd2_0_to_1[j]); \
-            }                                                            \
-        }                                                                \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);                   \
-                                                                         \
-        elapsed_time = get_elapsed_time(&time_start, &time_end);         \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);          \
-                                                                         \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {                   \
-            f_result[0] += f_result[i];                                  \
-        }                                                                \
-        printf("Control result: %f\n", f_result[0]);                     \
+/**
+ * Generic macro for creating wrappers for measuring elapsed time for libm
+ * math functions. The function FNAME of the floating point type TYPE ('f',
+ * 'd' or 'l') is called with the arguments ARGS (that can refer to the index
+ * 'j' of the random inputs) and the results are stored in the RESULT array.
+ * Each selected input range of the function is measured separately: an
+ * untimed warmup pass is followed by 'k' timed samples of 'n' iterations
+ * each. FORMAT is used for formatting the control result.
+ *
+ * In the throughput mode, the calls are independent of each other. In the
+ * latency mode, the index of the inputs of each call is offset by a byte of
+ * the previous result masked with 'chain_mask'. The offset is always zero,
+ * so the inputs are the same, but each call has to wait for the previous
+ * one to finish.
+ */
+#define TEST_MATH_FUNCTION(FNAME, TYPE, RESULT, ARGS, FORMAT)                  \
+    void test_loop_##FNAME(int32_t n, int32_t k, const char* range,            \
+                           bool latency) {                                     \
+        struct timespec time_start, time_end;                                  \
+        unsigned char mask = chain_mask;                                       \
+        char control_result[CONTROL_RESULT_LEN];                               \
+                                                                               \
+        for (size_t d = 0; d < NUMBER_OF_FUNCTION_DOMAINS; ++d) {              \
+            const struct FunctionDomain* domain = &function_domains[d];        \
+                                                                               \
+            if (!is_selected_domain(domain, #FNAME, TYPE, range)) {            \
+                continue;                                                      \
+            }                                                                  \
+            generate_inputs(domain, TYPE);                                     \
+            /* Sample -1 is the warmup pass */                                 \
+            for (int32_t s = -1; s < k; ++s) {                                 \
+                clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);               \
+                if (latency) {                                                 \
+                    size_t chain = 0;                                          \
+                    for (size_t i = 0; i < n; ++i) {                           \
+                        for (size_t c = 0; c < random_data_len; ++c) {         \
+                            size_t j = c + chain;                              \
+                            RESULT[c] = FNAME ARGS;                            \
+                            chain = *(unsigned char*)&RESULT[c] & mask;        \
+                        }                                                      \
+                    }                                                          \
+                } else {                                                       \
+                    for (size_t i = 0; i < n; ++i) {                           \
+                        for (size_t j = 0; j < random_data_len; ++j) {         \
+                            RESULT[j] = FNAME ARGS;                            \
+                        }                                                      \
+                    }                                                          \
+                }                                                              \
+                clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);                 \
+                if (s >= 0) {                                                  \
+                    sample_times[s] =                                          \
+                        get_elapsed_time(&time_start, &time_end);              \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            for (size_t i = 1; i < random_data_len; i++) {                     \
+                RESULT[0] += RESULT[i];                                        \
+            }                                                                  \
+            snprintf(control_result, sizeof(control_result), FORMAT,           \
+                     RESULT[0]);                                               \
+            print_result(#FNAME, domain->range,                                \
+                         latency ? "latency" : "throughput", n, k, 0, NULL,    \
+                         control_result);                                      \
+        }                                                                      \
     }
 
+/**
+ * Macros for creating wrappers for measuring elapsed time for libm math
+ * functions whose base floating point type is 'float'.
+ */
+#define TEST_MATH_FUNCTION_F_F(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'f', f_result, (f_rnd1[j]), "%f")
+
+#define TEST_MATH_FUNCTION_I_F(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'f', i_result, (f_rnd1[j]), "%d")
+
+#define TEST_MATH_FUNCTION_F_FF(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'f', f_result, (f_rnd1[j], f_rnd2[j]), "%f")
+
 /* create source code of numerous functions using macros above */
 
 TEST_MATH_FUNCTION_F_F(sqrtf)
@@ -191,74 +399,14 @@ TEST_MATH_FUNCTION_F_F(tgammaf)
  * Macros for creating wrappers for measuring elapsed time for libm math
  * functions whose base floating point type is 'double'.
  */
-#define TEST_MATH_FUNCTION_D_D(FNAME)                            \
-    void test_loop_##FNAME(int32_t n) {                          \
-        struct timespec time_start, time_end;                    \
-        uint64_t elapsed_time;                                   \
-                                                                 \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);         \
-        printf("* Profiling function %s():\t", #FNAME);          \
-        for (size_t i = 0; i < n; ++i) {                         \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {       \
-                d_result[j] = FNAME(d_rnd1_0_to_1[j]);           \
-            }                                                    \
-        }                                                        \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);           \
-                                                                 \
-        elapsed_time = get_elapsed_time(&time_start, &time_end); \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);  \
-                                                                 \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {           \
-            d_result[0] += d_result[i];                          \
-        }                                                        \
-        printf("Control result: %f\n", d_result[0]);             \
-    }
+#define TEST_MATH_FUNCTION_D_D(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'd', d_result, (d_rnd1[j]), "%f")
 
-#define TEST_MATH_FUNCTION_I_D(FNAME)                            \
-    void test_loop_##FNAME(int32_t n) {                          \
-        struct timespec time_start, time_end;                    \
-        uint64_t elapsed_time;                                   \
-                                                                 \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);         \
-        printf("* Profiling function %s():\t", #FNAME);          \
-        for (size_t i = 0; i < n; ++i) {                         \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {       \
-                i_result[j] = FNAME(d_rnd1_0_to_1[j]);           \
-            }                                                    \
-        }                                                        \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);           \
-                                                                 \
-        elapsed_time = get_elapsed_time(&time_start, &time_end); \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);  \
-                                                                 \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {           \
-            i_result[0] += i_result[i];                          \
-        }                                                        \
-        printf("Control result: %d\n", i_result[0]);             \
-    }
+#define TEST_MATH_FUNCTION_I_D(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'd', i_result, (d_rnd1[j]), "%d")
 
-#define TEST_MATH_FUNCTION_D_DD(FNAME)                                   \
-    void test_loop_##FNAME(int32_t n) {                                  \
-        struct timespec time_start, time_end;                            \
-        uint64_t elapsed_time;                                           \
-                                                                         \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);                 \
-        printf("* Profiling function %s():\t", #FNAME);                  \
-        for (size_t i = 0; i < n; ++i) {                                 \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {               \
-                d_result[j] = FNAME(d_rnd1_0_to_1[j], d_rnd2_0_to_1[j]); \
-            }                                                            \
-        }                                                                \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);                   \
-                                                                         \
-        elapsed_time = get_elapsed_time(&time_start, &time_end);         \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);          \
-                                                                         \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {                   \
-            d_result[0] += d_result[i];                                  \
-        }                                                                \
-        printf("Control result: %f\n", d_result[0]);                     \
-    }
+#define TEST_MATH_FUNCTION_D_DD(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'd', d_result, (d_rnd1[j], d_rnd2[j]), "%f")
 
 /* create source code of numerous functions using macros above */
 
@@ -301,74 +449,14 @@ TEST_MATH_FUNCTION_D_D(tgamma)
  * Macros for creating wrappers for measuring elapsed time for libm math
  * functions whose base floating point type is 'long double'.
  */
-#define TEST_MATH_FUNCTION_L_L(FNAME)                            \
-    void test_loop_##FNAME(int32_t n) {                          \
-        struct timespec time_start, time_end;                    \
-        uint64_t elapsed_time;                                   \
-                                                                 \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);         \
-        printf("* Profiling function %s():\t", #FNAME);          \
-        for (size_t i = 0; i < n; ++i) {                         \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {       \
-                l_result[j] = FNAME(l_rnd1_0_to_1[j]);           \
-            }                                                    \
-        }                                                        \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);           \
-                                                                 \
-        elapsed_time = get_elapsed_time(&time_start, &time_end); \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);  \
-                                                                 \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {           \
-            l_result[0] += l_result[i];                          \
-        }                                                        \
-        printf("Control result: %Lf\n", l_result[0]);            \
-    }
+#define TEST_MATH_FUNCTION_L_L(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'l', l_result, (l_rnd1[j]), "%Lf")
 
-#define TEST_MATH_FUNCTION_I_L(FNAME)                            \
-    void test_loop_##FNAME(int32_t n) {                          \
-        struct timespec time_start, time_end;                    \
-        uint64_t elapsed_time;                                   \
-                                                                 \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);         \
-        printf("* Profiling function %s():\t", #FNAME);          \
-        for (size_t i = 0; i < n; ++i) {                         \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {       \
-                i_result[j] = FNAME(l_rnd1_0_to_1[j]);           \
-            }                                                    \
-        }                                                        \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);           \
-                                                                 \
-        elapsed_time = get_elapsed_time(&time_start, &time_end); \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);  \
-                                                                 \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {           \
-            i_result[0] += i_result[i];                          \
-        }                                                        \
-        printf("Control result: %i\n", i_result[0]);             \
-    }
+#define TEST_MATH_FUNCTION_I_L(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'l', i_result, (l_rnd1[j]), "%i")
 
-#define TEST_MATH_FUNCTION_L_LL(FNAME)                                   \
-    void test_loop_##FNAME(int32_t n) {                                  \
-        struct timespec time_start, time_end;                            \
-        uint64_t elapsed_time;                                           \
-                                                                         \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);                 \
-        printf("* Profiling function %s():\t", #FNAME);                  \
-        for (size_t i = 0; i < n; ++i) {                                 \
-            for (size_t j = 0; j < RANDOM_DATA_LEN; ++j) {               \
-                l_result[j] = FNAME(l_rnd1_0_to_1[j], l_rnd2_0_to_1[j]); \
-            }                                                            \
-        }                                                                \
-        clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);                   \
-                                                                         \
-        elapsed_time = get_elapsed_time(&time_start, &time_end);         \
-        printf("Elapsed time: %" PRIu64 " ms\t", elapsed_time);          \
-                                                                         \
-        for (size_t i = 1; i < RANDOM_DATA_LEN; i++) {                   \
-            l_result[0] += l_result[i];                                  \
-        }                                                                \
-        printf("Control result: %Lf\n", l_result[0]);                    \
-    }
+#define TEST_MATH_FUNCTION_L_LL(FNAME) \
+    TEST_MATH_FUNCTION(FNAME, 'l', l_result, (l_rnd1[j], l_rnd2[j]), "%Lf")
 
 /* create source code of numerous functions using macros above */
 
@@ -407,13 +495,93 @@ TEST_MATH_FUNCTION_L_L(erfcl)
 TEST_MATH_FUNCTION_L_L(lgammal)
 TEST_MATH_FUNCTION_L_L(tgammal)
 
+/**
+ * Macro for creating wrappers for measuring elapsed time for the vector
+ * versions of libm math functions whose base floating point type is
+ * 'double' (see "vector_math.h"). For each selected input range, the scalar
+ * function FNAME is timed first, and then its vector version is timed on the
+ * same inputs, two at a time. The statistics of the vector version are
+ * printed, followed by its per-element speedup over the scalar function.
+ */
+#define TEST_VECTOR_FUNCTION_D_D(FNAME)                                        \
+    void test_vector_loop_##FNAME(int32_t n, int32_t k, const char* range) {   \
+        struct timespec time_start, time_end;                                  \
+        size_t last = random_data_len - 1;                                     \
+        double scalar_time;                                                    \
+        char control_result[CONTROL_RESULT_LEN];                               \
+                                                                               \
+        for (size_t d = 0; d < NUMBER_OF_FUNCTION_DOMAINS; ++d) {              \
+            const struct FunctionDomain* domain = &function_domains[d];        \
+                                                                               \
+            if (!is_selected_domain(domain, #FNAME, 'd', range)) {             \
+                continue;                                                      \
+            }                                                                  \
+            generate_inputs(domain, 'd');                                      \
+            /* Scalar samples, sample -1 is the warmup pass */                 \
+            for (int32_t s = -1; s < k; ++s) {                                 \
+                clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);               \
+                for (size_t i = 0; i < n; ++i) {                               \
+                    for (size_t j = 0; j < random_data_len; ++j) {             \
+                        d_result[j] = FNAME(d_rnd1[j]);                        \
+                    }                                                          \
+                }                                                              \
+                clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);                 \
+                if (s >= 0) {                                                  \
+                    sample_times[s] =                                          \
+                        get_elapsed_time(&time_start, &time_end);              \
+                }                                                              \
+            }                                                                  \
+            scalar_time = get_median_time(k);                                  \
+            /* Vector samples, an odd last input uses the scalar function */   \
+            for (int32_t s = -1; s < k; ++s) {                                 \
+                clock_gettime(CLOCK_MONOTONIC_RAW, &time_start);               \
+                for (size_t i = 0; i < n; ++i) {                               \
+                    for (size_t j = 0; j + 1 < random_data_len; j += 2) {      \
+                        v2df x;                                                \
+                        memcpy(&x, &d_rnd1[j], sizeof(x));                     \
+                        x = VECTOR_FUNCTION(FNAME)(x);                         \
+                        memcpy(&d_result[j], &x, sizeof(x));                   \
+                    }                                                          \
+                    if (random_data_len % 2) {                                 \
+                        d_result[last] = FNAME(d_rnd1[last]);                  \
+                    }                                                          \
+                }                                                              \
+                clock_gettime(CLOCK_MONOTONIC_RAW, &time_end);                 \
+                if (s >= 0) {                                                  \
+                    sample_times[s] =                                          \
+                        get_elapsed_time(&time_start, &time_end);              \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            for (size_t i = 1; i < random_data_len; i++) {                     \
+                d_result[0] += d_result[i];                                    \
+            }                                                                  \
+            snprintf(control_result, sizeof(control_result), "%f",             \
+                     d_result[0]);                                             \
+            print_result(#FNAME, domain->range, "vector", n, k,                \
+                         scalar_time / get_median_time(k),                     \
+                         VECTOR_IMPLEMENTATION, control_result);               \
+        }                                                                      \
+    }
+
+/* create source code of the vector functions using the macro above */
+
+TEST_VECTOR_FUNCTION_D_D(sin)
+TEST_VECTOR_FUNCTION_D_D(cos)
+TEST_VECTOR_FUNCTION_D_D(exp)
+TEST_VECTOR_FUNCTION_D_D(log)
+
 int main(int argc, char* argv[]) {
     /******************************** Parse the command line flags ********************************/
     int c;
     long selected_iterations = -1;
+    long selected_samples = DEFAULT_NUMBER_OF_SAMPLES;
     char* selected_type = NULL;
+    char* selected_range = NULL;
+    bool latency_mode = false;
+    bool vector_mode = false;
     char* selected_function = NULL;
-    while ((c = getopt(argc, argv, "i:f:t:")) != -1) {
+    while ((c = getopt(argc, argv, "i:k:f:t:r:m:l:o:")) != -1) {
         switch (c) {
             case 'i':
                 selected_iterations = atoi(optarg);
@@ -423,6 +591,15 @@ int main(int argc, char* argv[]) {
                     exit(EXIT_FAILURE);
                 }
                 break;
+            case 'k':
+                selected_samples = atoi(optarg);
+                /* Check for valid numbers (not strings and in range) */
+                if (selected_samples < 1 || selected_samples > MAX_NUMBER_OF_SAMPLES) {
+                    fprintf(stderr, "Error ... Number of samples must be between 1 and %d.\n",
+                            MAX_NUMBER_OF_SAMPLES);
+                    exit(EXIT_FAILURE);
+                }
+                break;
             case 'f':
                 selected_function = optarg;
                 break;
@@ -434,6 +611,50 @@ int main(int argc, char* argv[]) {
                 }
                 selected_type = optarg;
                 break;
+            case 'r':
+                /* Check for valid input range */
+                selected_range = NULL;
+                for (size_t r = 0; r < NUMBER_OF_FUNCTION_RANGES; ++r) {
+                    if (!strcmp(optarg, function_ranges[r])) {
+                        selected_range = optarg;
+                    }
+                }
+                if (selected_range == NULL) {
+                    fprintf(stderr, "Error ... Input range must either be 'normal', 'tiny', 'huge' or 'near-singular'.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'm':
+                /* Check for valid measurement mode */
+                if (strcmp(optarg, "latency") && strcmp(optarg, "throughput") && strcmp(optarg, "vector")) {
+                    fprintf(stderr, "Error ... Mode must either be 'latency', 'throughput' or 'vector'.\n");
+                    exit(EXIT_FAILURE);
+                }
+                latency_mode = !strcmp(optarg, "latency");
+                vector_mode = !strcmp(optarg, "vector");
+                break;
+            case 'l':
+                random_data_len = atoi(optarg);
+                /* Check for valid numbers (not strings and in range) */
+                if (atoi(optarg) < 1 || random_data_len > MAX_RANDOM_DATA_LEN) {
+                    fprintf(stderr, "Error ... Length of the input data must be between 1 and %d.\n",
+                            MAX_RANDOM_DATA_LEN);
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'o':
+                /* Check for valid output format */
+                if (!strcmp(optarg, "text")) {
+                    output_format = OUTPUT_TEXT;
+                } else if (!strcmp(optarg, "csv")) {
+                    output_format = OUTPUT_CSV;
+                } else if (!strcmp(optarg, "json")) {
+                    output_format = OUTPUT_JSON;
+                } else {
+                    fprintf(stderr, "Error ... Output format must either be 'text', 'csv' or 'json'.\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
             default:
                 break;
         }
@@ -591,296 +812,346 @@ int main(int argc, char* argv[]) {
     bool f_lgammal = default_flag || !strcmp(selected_function, "lgammal");
     bool f_tgammal = default_flag || !strcmp(selected_function, "tgammal");
 
-    /* initialize arrays for random inputs */
-    srand(1);
-    for (size_t i = 0; i < RANDOM_DATA_LEN; ++i) {
-        f_rnd1_0_to_1[i] = (float)rand() / (float)RAND_MAX;
-        f_rnd2_0_to_1[i] = (float)rand() / (float)RAND_MAX;
-        d_rnd1_0_to_1[i] = (double)rand() / (double)RAND_MAX;
-        d_rnd2_0_to_1[i] = (double)rand() / (double)RAND_MAX;
-        l_rnd1_0_to_1[i] = (long double)rand() / (long double)RAND_MAX;
-        l_rnd2_0_to_1[i] = (long double)rand() / (long double)RAND_MAX;
+    /* allocate arrays for random inputs and results */
+    f_rnd1 = malloc(random_data_len * sizeof(float));
+    f_rnd2 = malloc(random_data_len * sizeof(float));
+    d_rnd1 = malloc(random_data_len * sizeof(double));
+    d_rnd2 = malloc(random_data_len * sizeof(double));
+    l_rnd1 = malloc(random_data_len * sizeof(long double));
+    l_rnd2 = malloc(random_data_len * sizeof(long double));
+    i_result = malloc(random_data_len * sizeof(int));
+    f_result = malloc(random_data_len * sizeof(float));
+    d_result = malloc(random_data_len * sizeof(double));
+    l_result = malloc(random_data_len * sizeof(long double));
+    if (!f_rnd1 || !f_rnd2 || !d_rnd1 || !d_rnd2 || !l_rnd1 || !l_rnd2 ||
+        !i_result || !f_result || !d_result || !l_result) {
+        fprintf(stderr, "Error ... Failed to allocate the input and result arrays.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* print the beginning of the results */
+    if (output_format == OUTPUT_CSV) {
+        printf("function,range,mode,median,min,stddev,samples,speedup,implementation,control_result\n");
+    } else if (output_format == OUTPUT_JSON) {
+        printf("[\n");
     }
 
     /* execute measurements */
+    if (vector_mode) {
+        /* Only the functions with vector versions are measured */
+        if (d_double) {
+            if (f_sin) {
+                test_vector_loop_sin(selected_iterations, selected_samples, selected_range);
+            }
+            if (f_cos) {
+                test_vector_loop_cos(selected_iterations, selected_samples, selected_range);
+            }
+            if (f_exp) {
+                test_vector_loop_exp(selected_iterations, selected_samples, selected_range);
+            }
+            if (f_log) {
+                test_vector_loop_log(selected_iterations, selected_samples, selected_range);
+            }
+        }
+        d_float = false;
+        d_double = false;
+        d_longdouble = false;
+    }
+
     if (d_float) {
         if (f_sqrtf) {
-            test_loop_sqrtf(selected_iterations);
+            test_loop_sqrtf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cbrtf) {
-            test_loop_cbrtf(selected_iterations);
+            test_loop_cbrtf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_hypotf) {
-            test_loop_hypotf(selected_iterations);
+            test_loop_hypotf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_powf) {
-            test_loop_powf(selected_iterations);
+            test_loop_powf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_expf) {
-            test_loop_expf(selected_iterations);
+            test_loop_expf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_exp2f) {
-            test_loop_exp2f(selected_iterations);
+            test_loop_exp2f(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_expm1f) {
-            test_loop_expm1f(selected_iterations);
+            test_loop_expm1f(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_logf) {
-            test_loop_logf(selected_iterations);
+            test_loop_logf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log2f) {
-            test_loop_log2f(selected_iterations);
+            test_loop_log2f(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log10f) {
-            test_loop_log10f(selected_iterations);
+            test_loop_log10f(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log1pf) {
-            test_loop_log1pf(selected_iterations);
+            test_loop_log1pf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_ilogbf) {
-            test_loop_ilogbf(selected_iterations);
+            test_loop_ilogbf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_logbf) {
-            test_loop_logbf(selected_iterations);
+            test_loop_logbf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_sinf) {
-            test_loop_sinf(selected_iterations);
+            test_loop_sinf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cosf) {
-            test_loop_cosf(selected_iterations);
+            test_loop_cosf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tanf) {
-            test_loop_tanf(selected_iterations);
+            test_loop_tanf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_asinf) {
-            test_loop_asinf(selected_iterations);
+            test_loop_asinf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_acosf) {
-            test_loop_acosf(selected_iterations);
+            test_loop_acosf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atanf) {
-            test_loop_atanf(selected_iterations);
+            test_loop_atanf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atan2f) {
-            test_loop_atan2f(selected_iterations);
+            test_loop_atan2f(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_sinhf) {
-            test_loop_sinhf(selected_iterations);
+            test_loop_sinhf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_coshf) {
-            test_loop_coshf(selected_iterations);
+            test_loop_coshf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tanhf) {
-            test_loop_tanhf(selected_iterations);
+            test_loop_tanhf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_asinhf) {
-            test_loop_asinhf(selected_iterations);
+            test_loop_asinhf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_acoshf) {
-            test_loop_acoshf(selected_iterations);
+            test_loop_acoshf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atanhf) {
-            test_loop_atanhf(selected_iterations);
+            test_loop_atanhf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_erff) {
-            test_loop_erff(selected_iterations);
+            test_loop_erff(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_erfcf) {
-            test_loop_erfcf(selected_iterations);
+            test_loop_erfcf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_lgammaf) {
-            test_loop_lgammaf(selected_iterations);
+            test_loop_lgammaf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tgammaf) {
-            test_loop_tgammaf(selected_iterations);
+            test_loop_tgammaf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
     }
 
     if (d_double) {
         if (f_sqrt) {
-            test_loop_sqrt(selected_iterations);
+            test_loop_sqrt(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cbrt) {
-            test_loop_cbrt(selected_iterations);
+            test_loop_cbrt(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_hypot) {
-            test_loop_hypot(selected_iterations);
+            test_loop_hypot(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_pow) {
-            test_loop_pow(selected_iterations);
+            test_loop_pow(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_exp) {
-            test_loop_exp(selected_iterations);
+            test_loop_exp(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_exp2) {
-            test_loop_exp2(selected_iterations);
+            test_loop_exp2(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_expm1) {
-            test_loop_expm1(selected_iterations);
+            test_loop_expm1(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log) {
-            test_loop_log(selected_iterations);
+            test_loop_log(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log2) {
-            test_loop_log2(selected_iterations);
+            test_loop_log2(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log10) {
-            test_loop_log10(selected_iterations);
+            test_loop_log10(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log1p) {
-            test_loop_log1p(selected_iterations);
+            test_loop_log1p(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_ilogb) {
-            test_loop_ilogb(selected_iterations);
+            test_loop_ilogb(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_logb) {
-            test_loop_logb(selected_iterations);
+            test_loop_logb(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_sin) {
-            test_loop_sin(selected_iterations);
+            test_loop_sin(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cos) {
-            test_loop_cos(selected_iterations);
+            test_loop_cos(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tan) {
-            test_loop_tan(selected_iterations);
+            test_loop_tan(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_asin) {
-            test_loop_asin(selected_iterations);
+            test_loop_asin(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_acos) {
-            test_loop_acos(selected_iterations);
+            test_loop_acos(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atan) {
-            test_loop_atan(selected_iterations);
+            test_loop_atan(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atan2) {
-            test_loop_atan2(selected_iterations);
+            test_loop_atan2(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_sinh) {
-            test_loop_sinh(selected_iterations);
+            test_loop_sinh(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cosh) {
-            test_loop_cosh(selected_iterations);
+            test_loop_cosh(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tanh) {
-            test_loop_tanh(selected_iterations);
+            test_loop_tanh(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_asinh) {
-            test_loop_asinh(selected_iterations);
+            test_loop_asinh(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_acosh) {
-            test_loop_acosh(selected_iterations);
+            test_loop_acosh(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atanh) {
-            test_loop_atanh(selected_iterations);
+            test_loop_atanh(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_erf) {
-            test_loop_erf(selected_iterations);
+            test_loop_erf(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_erfc) {
-            test_loop_erfc(selected_iterations);
+            test_loop_erfc(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_lgamma) {
-            test_loop_lgamma(selected_iterations);
+            test_loop_lgamma(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tgamma) {
-            test_loop_tgamma(selected_iterations);
+            test_loop_tgamma(selected_iterations, selected_samples, selected_range, latency_mode);
         }
     }
 
     if (d_longdouble) {
         if (f_sqrtl) {
-            test_loop_sqrtl(selected_iterations);
+            test_loop_sqrtl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cbrtl) {
-            test_loop_cbrtl(selected_iterations);
+            test_loop_cbrtl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_hypotl) {
-            test_loop_hypotl(selected_iterations);
+            test_loop_hypotl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_powl) {
-            test_loop_powl(selected_iterations);
+            test_loop_powl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_expl) {
-            test_loop_expl(selected_iterations);
+            test_loop_expl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_exp2l) {
-            test_loop_exp2l(selected_iterations);
+            test_loop_exp2l(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_expm1l) {
-            test_loop_expm1l(selected_iterations);
+            test_loop_expm1l(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_logl) {
-            test_loop_logl(selected_iterations);
+            test_loop_logl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log2l) {
-            test_loop_log2l(selected_iterations);
+            test_loop_log2l(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log10l) {
-            test_loop_log10l(selected_iterations);
+            test_loop_log10l(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_log1pl) {
-            test_loop_log1pl(selected_iterations);
+            test_loop_log1pl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_ilogbl) {
-            test_loop_ilogbl(selected_iterations);
+            test_loop_ilogbl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_logbl) {
-            test_loop_logbl(selected_iterations);
+            test_loop_logbl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_sinl) {
-            test_loop_sinl(selected_iterations);
+            test_loop_sinl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_cosl) {
-            test_loop_cosl(selected_iterations);
+            test_loop_cosl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tanl) {
-            test_loop_tanl(selected_iterations);
+            test_loop_tanl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_asinl) {
-            test_loop_asinl(selected_iterations);
+            test_loop_asinl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_acosl) {
-            test_loop_acosl(selected_iterations);
+            test_loop_acosl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atanl) {
-            test_loop_atanl(selected_iterations);
+            test_loop_atanl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atan2l) {
-            test_loop_atan2l(selected_iterations);
+            test_loop_atan2l(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_sinhl) {
-            test_loop_sinhl(selected_iterations);
+            test_loop_sinhl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_coshl) {
-            test_loop_coshl(selected_iterations);
+            test_loop_coshl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tanhl) {
-            test_loop_tanhl(selected_iterations);
+            test_loop_tanhl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_asinhl) {
-            test_loop_asinhl(selected_iterations);
+            test_loop_asinhl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_acoshl) {
-            test_loop_acoshl(selected_iterations);
+            test_loop_acoshl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_atanhl) {
-            test_loop_atanhl(selected_iterations);
+            test_loop_atanhl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_erfl) {
-            test_loop_erfl(selected_iterations);
+            test_loop_erfl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_erfcl) {
-            test_loop_erfcl(selected_iterations);
+            test_loop_erfcl(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_lgammal) {
-            test_loop_lgammal(selected_iterations);
+            test_loop_lgammal(selected_iterations, selected_samples, selected_range, latency_mode);
         }
         if (f_tgammal) {
-            test_loop_tgammal(selected_iterations);
+            test_loop_tgammal(selected_iterations, selected_samples, selected_range, latency_mode);
         }
     }
 
-    return;
+    /* print the end of the results */
+    if (output_format == OUTPUT_JSON) {
+        printf("%s]\n", number_of_results ? "\n" : "");
+    }
+
+    free(f_rnd1);
+    free(f_rnd2);
+    free(d_rnd1);
+    free(d_rnd2);
+    free(l_rnd1);
+    free(l_rnd2);
+    free(i_result);
+    free(f_result);
+    free(d_result);
+    free(l_result);
+
+    return 0;
 }
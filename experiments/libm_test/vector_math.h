@@ -0,0 +1,246 @@
+/*
+ *  Vector versions of libm functions used by the vector mode of math.c.
+ *
+ *  This file is a part of the project "TCG Continuous Benchmarking".
+ *
+ *  Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+ *  Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VECTOR_MATH_H
+#define VECTOR_MATH_H
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * Vector of two 'double' values, and the vectors of two 64-bit integers of
+ * the same size that are used for comparison results and bit manipulation.
+ * GCC lowers the operations to scalar code on targets without SIMD units.
+ */
+typedef double v2df __attribute__((vector_size(16)));
+typedef int64_t v2di __attribute__((vector_size(16)));
+typedef uint64_t v2du __attribute__((vector_size(16)));
+
+/**
+ * On x86_64, glibc provides the libmvec vector functions since version 2.22.
+ * Their names follow the vector function ABI: '_ZGVbN2v_sin' is the SSE
+ * version of sin() that takes and returns two 'double' values. Elsewhere,
+ * or when compiled with -DNO_LIBMVEC, the in-tree polynomial versions below
+ * are used.
+ */
+#if defined(__x86_64__) && defined(__GLIBC_PREREQ) && !defined(NO_LIBMVEC)
+#if __GLIBC_PREREQ(2, 22)
+#define HAVE_LIBMVEC
+#endif
+#endif
+
+#ifdef HAVE_LIBMVEC
+v2df _ZGVbN2v_sin(v2df x);
+v2df _ZGVbN2v_cos(v2df x);
+v2df _ZGVbN2v_exp(v2df x);
+v2df _ZGVbN2v_log(v2df x);
+
+#define VECTOR_FUNCTION(FNAME) _ZGVbN2v_##FNAME
+#define VECTOR_IMPLEMENTATION "libmvec"
+#else
+#define VECTOR_FUNCTION(FNAME) vector_##FNAME
+#define VECTOR_IMPLEMENTATION "in-tree"
+#endif
+
+/* Adding and subtracting 1.5 * 2^52 rounds a double to the nearest integer */
+#define ROUND_MAGIC 6755399441055744.0
+
+/* ln(2) split into a high part with trailing zero bits and a low part */
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+
+/* pi/2 split into three parts of 33 bits (from fdlibm) */
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050630396597660e-11
+#define PIO2_3 2.02226624871116645580e-21
+
+/* Largest argument of sin() and cos() reduced with the three parts of pi/2 */
+#define MAX_REDUCED_ARGUMENT 1e5
+
+/**
+ * Utility function for creating a vector with the same value in both lanes.
+ */
+static inline v2df vector_broadcast(double value) {
+    return (v2df){value, value};
+}
+
+/**
+ * Utility function for selecting the lanes of 'a' where 'mask' is set (all
+ * ones), and the lanes of 'b' elsewhere.
+ */
+static inline v2df vector_select(v2di mask, v2df a, v2df b) {
+    return (v2df)(((v2di)a & mask) | ((v2di)b & ~mask));
+}
+
+/**
+ * Utility function for building 2^k from the integers k in [-1022, 1023].
+ */
+static inline v2df vector_pow2(v2di k) {
+    return (v2df)((k + 1023) << 52);
+}
+
+/**
+ * Vector version of exp(). The argument is reduced to x = k * ln(2) + r
+ * with |r| <= ln(2) / 2, and exp(r) is evaluated with its Taylor series.
+ * The result is scaled by 2^k in two steps, so subnormal results are
+ * rounded gradually.
+ */
+static inline v2df vector_exp(v2df x) {
+    v2df t, k, r, p;
+    v2di ki, k1;
+
+    /* Beyond these bounds, the result overflows or underflows anyway */
+    x = vector_select(x > 710.0, vector_broadcast(710.0), x);
+    x = vector_select(x < -746.0, vector_broadcast(-746.0), x);
+
+    t = x * 1.4426950408889634 + ROUND_MAGIC;
+    k = t - ROUND_MAGIC;
+    ki = (v2di)t - (v2di)vector_broadcast(ROUND_MAGIC);
+    r = x - k * LN2_HI - k * LN2_LO;
+
+    p = vector_broadcast(1.0 / 6227020800.0);
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    k1 = ki >> 1;
+    return p * vector_pow2(k1) * vector_pow2(ki - k1);
+}
+
+/**
+ * Vector version of log(). The argument is split into x = 2^e * m with
+ * sqrt(2)/2 < m <= sqrt(2), and log(m) is evaluated as 2 * atanh(s) where
+ * s = (m - 1) / (m + 1).
+ */
+static inline v2df vector_log(v2df x) {
+    v2di subnormal = x < DBL_MIN;
+    v2di bits, e, big;
+    v2df y, m, s, z, p, ed, result;
+
+    /* Normalize subnormal inputs */
+    y = vector_select(subnormal, x * 0x1p54, x);
+    bits = (v2di)y;
+    e = ((bits >> 52) & 0x7ff) - 1023 - (subnormal & 54);
+    m = (v2df)((bits & 0x000fffffffffffff) | 0x3ff0000000000000);
+    big = m > 1.4142135623730951;
+    m = vector_select(big, m * 0.5, m);
+    e = e - big;
+
+    s = (m - 1.0) / (m + 1.0);
+    z = s * s;
+    p = vector_broadcast(1.0 / 19.0);
+    p = p * z + 1.0 / 17.0;
+    p = p * z + 1.0 / 15.0;
+    p = p * z + 1.0 / 13.0;
+    p = p * z + 1.0 / 11.0;
+    p = p * z + 1.0 / 9.0;
+    p = p * z + 1.0 / 7.0;
+    p = p * z + 1.0 / 5.0;
+    p = p * z + 1.0 / 3.0;
+    p = p * z + 1.0;
+    p = 2.0 * s * p;
+
+    ed = (v2df)(e + (v2di)vector_broadcast(ROUND_MAGIC)) - ROUND_MAGIC;
+    result = ed * LN2_HI + (p + ed * LN2_LO);
+
+    /* Special cases: log(0) = -inf, log(x < 0) = NaN, log(inf) = inf */
+    result = vector_select(x == 0.0, vector_broadcast(-INFINITY), result);
+    result = vector_select(x < 0.0, vector_broadcast(NAN), result);
+    return vector_select((x != x) | (x == INFINITY), x, result);
+}
+
+/**
+ * Utility function for evaluating the Taylor series of sin(r) and cos(r)
+ * for |r| <= pi/4 and selecting the lanes according to the quadrant 'q' of
+ * the original argument. 'cosine' shifts the quadrant by one, since
+ * cos(x) = sin(x + pi/2).
+ */
+static inline v2df vector_sincos(v2df x, int cosine) {
+    v2df t, k, r, z, s, c, result;
+    v2di q;
+
+    /* Arguments that are too large for the reduction use scalar functions */
+    v2di large = ((v2di)x & INT64_MAX) >
+                 (v2di)vector_broadcast(MAX_REDUCED_ARGUMENT);
+    if (large[0] | large[1]) {
+        return cosine ? (v2df){cos(x[0]), cos(x[1])}
+                      : (v2df){sin(x[0]), sin(x[1])};
+    }
+
+    t = x * 0.63661977236758134308 + ROUND_MAGIC;
+    k = t - ROUND_MAGIC;
+    q = (v2di)t - (v2di)vector_broadcast(ROUND_MAGIC) + cosine;
+    r = x - k * PIO2_1 - k * PIO2_2 - k * PIO2_3;
+    z = r * r;
+
+    s = vector_broadcast(1.0 / 355687428096000.0);
+    s = s * z - 1.0 / 1307674368000.0;
+    s = s * z + 1.0 / 6227020800.0;
+    s = s * z - 1.0 / 39916800.0;
+    s = s * z + 1.0 / 362880.0;
+    s = s * z - 1.0 / 5040.0;
+    s = s * z + 1.0 / 120.0;
+    s = s * z - 1.0 / 6.0;
+    s = r + r * z * s;
+
+    c = vector_broadcast(1.0 / 20922789888000.0);
+    c = c * z - 1.0 / 87178291200.0;
+    c = c * z + 1.0 / 479001600.0;
+    c = c * z - 1.0 / 3628800.0;
+    c = c * z + 1.0 / 40320.0;
+    c = c * z - 1.0 / 720.0;
+    c = c * z + 1.0 / 24.0;
+    c = c * z - 0.5;
+    c = c * z + 1.0;
+
+    /* Odd quadrants use the cosine series, quadrants 2 and 3 are negated */
+    result = vector_select((q & 1) == 1, c, s);
+    return (v2df)((v2du)result ^ ((v2du)(q & 2) << 62));
+}
+
+/**
+ * Vector version of sin().
+ */
+static inline v2df vector_sin(v2df x) {
+    return vector_sincos(x, 0);
+}
+
+/**
+ * Vector version of cos().
+ */
+static inline v2df vector_cos(v2df x) {
+    return vector_sincos(x, 1);
+}
+
+#endif
@@ -24,6 +24,7 @@ along with this program. If not, see <https://www.gnu.org/licenses/>.
 """
 
 import argparse
+import glob
 import multiprocessing
 import tempfile
 import os
@@ -33,6 +34,10 @@ import sys
 
 from typing import List
 
+# Host libc functions called by QEMU when a benchmark enters and leaves its
+# region of interest (see benchmarks/common/roi.h)
+ROI_BEGIN_FUNCTION = "*getpgid"
+ROI_END_FUNCTION = "*getsid"
 
 # --------------------------- GIT WRAPPERS --------------------------
 def git_bisect(qemu_path: str, qemu_build_path: str, command: str,
@@ -183,8 +188,44 @@ def make(qemu_build_path: str) -> None:
         clean_exit(qemu_build_path, run_make.stderr.decode("utf-8"))
 
 
+def get_callgrind_instructions(callgrind_out_dir_path: str,
+                               callgrind_stderr: str) -> int:
+    """
+    Get the number of instructions of the region of interest from the output
+    files of callgrind. A benchmark may enter the region of interest several
+    times (for example once for each kernel), and callgrind writes one file
+    at each exit, so the instructions of all these files are added up. If the
+    region of interest was not reached, the total number of instructions
+    printed by callgrind is returned instead.
+
+    Parameters:
+    callgrind_out_dir_path (str): Path to the callgrind output files
+    callgrind_stderr (str): Standard error output of callgrind
+
+    Returns:
+    (int): Number of instructions.
+    """
+    roi_instructions = 0
+    roi_reached = False
+    for out_file_path in sorted(
+            glob.glob(os.path.join(callgrind_out_dir_path, "*"))):
+        with open(out_file_path, "r") as out_file:
+            roi_dump = False
+            for line in out_file:
+                if line.startswith("desc: Trigger: --dump-before"):
+                    roi_dump = True
+                elif roi_dump and line.startswith(("summary:", "totals:")):
+                    roi_instructions += int(line.split()[1])
+                    roi_reached = True
+                    break
+
+    if roi_reached:
+        return roi_instructions
+    return int(callgrind_stderr.split("\n")[8].split(" ")[-1])
+
+
 def measure_instructions(tool: str, qemu_build_path: str, target: str,
-                         command: List[str]) -> int:
+                         command: List[str], roi: bool) -> int:
     """
     Measure the number of instructions when running an program with QEMU.
 
@@ -193,6 +234,7 @@ def measure_instructions(tool: str, qemu_build_path: str, target: str,
     qemu_build_path (str): Path to the build directory with configuration files
     target (str): QEMU target
     command (list): Program path and arguments
+    roi (bool): Measure only the region of interest of the program
 
     Returns:
     (int): Number of instructions.
@@ -202,17 +244,38 @@ def measure_instructions(tool: str, qemu_build_path: str, target: str,
                                  "qemu-{}".format(target))
     instructions = 0
     if tool == "perf":
+        perf_options = []
+        perf_env = None
+        pass_fds = ()
+        if roi:
+            # Start with the counters disabled, and let the program enable
+            # and disable them through the control file descriptors of perf
+            ctl_read_fd, ctl_write_fd = os.pipe()
+            ack_read_fd, ack_write_fd = os.pipe()
+            perf_options = ["--delay=-1",
+                            "--control=fd:{},{}".format(ctl_read_fd,
+                                                        ack_write_fd)]
+            perf_env = dict(os.environ,
+                            ROI_PERF_CTL_FD=str(ctl_write_fd),
+                            ROI_PERF_ACK_FD=str(ack_read_fd))
+            pass_fds = (ctl_read_fd, ctl_write_fd, ack_read_fd, ack_write_fd)
+
         run_perf = subprocess.run((["perf",
                                     "stat",
                                     "-x",
                                     " ",
                                     "-e",
-                                    "instructions",
-                                    qemu_exe_path]
+                                    "instructions"]
+                                   + perf_options
+                                   + [qemu_exe_path]
                                    + command),
                                   stdout=subprocess.DEVNULL,
                                   stderr=subprocess.PIPE,
+                                  env=perf_env,
+                                  pass_fds=pass_fds,
                                   check=False)
+        for fd in pass_fds:
+            os.close(fd)
         if run_perf.returncode:
             clean_exit(qemu_build_path, run_perf.stderr.decode("utf-8"))
 
@@ -221,22 +284,32 @@ def measure_instructions(tool: str, qemu_build_path: str, target: str,
             instructions = int(perf_output[0])
 
     elif tool == "callgrind":
-        with tempfile.NamedTemporaryFile() as tmpfile:
+        callgrind_options = []
+        if roi:
+            # Zero the counters when the program enters the region of
+            # interest, and dump them when it leaves it
+            callgrind_options = ["--zero-before={}".format(ROI_BEGIN_FUNCTION),
+                                 "--dump-before={}".format(ROI_END_FUNCTION)]
+
+        with tempfile.TemporaryDirectory() as tmpdir:
             run_callgrind = subprocess.run((["valgrind",
                                              "--tool=callgrind",
                                              "--callgrind-out-file={}".format(
-                                                 tmpfile.name),
-                                             qemu_exe_path]
+                                                 os.path.join(
+                                                     tmpdir, "callgrind.out"))]
+                                            + callgrind_options
+                                            + [qemu_exe_path]
                                             + command),
                                            stdout=subprocess.DEVNULL,
                                            stderr=subprocess.PIPE,
                                            check=False)
-        if run_callgrind.returncode:
-            clean_exit(qemu_build_path, run_callgrind.stderr.decode("utf-8"))
+            if run_callgrind.returncode:
+                clean_exit(qemu_build_path,
+                           run_callgrind.stderr.decode("utf-8"))
 
-        else:
-            callgrind_output = run_callgrind.stderr.decode("utf-8").split("\n")
-            instructions = int(callgrind_output[8].split(" ")[-1])
+            else:
+                instructions = get_callgrind_instructions(
+                    tmpdir, run_callgrind.stderr.decode("utf-8"))
 
     return instructions
 
@@ -247,7 +320,7 @@ def main():
 
     Syntax:
         bisect.py [-h] -s,--start START [-e,--end END] [-q,--qemu QEMU] \
-        --target TARGET --tool {perf,callgrind} -- \
+        --target TARGET --tool {perf,callgrind} [--roi] -- \
         <target executable> [<target executable options>]
 
     Arguments:
@@ -259,6 +332,7 @@ def main():
                     (default: Path to a GitHub QEMU clone)
         --target TARGET - QEMU target name
         --tool {perf,callgrind} - Underlying tool used for measurements
+        [--roi] - Measure only the region of interest of the benchmark
 
     Example of usage:
         bisect.py --start=fdd76fecdd --qemu=/path/to/qemu --target=ppc \
@@ -268,7 +342,7 @@ def main():
     # Parse the command line arguments
     parser = argparse.ArgumentParser(
         usage="bisect.py [-h] -s,--start START [-e,--end END] [-q,--qemu QEMU]"
-        " --target TARGET --tool {perf,callgrind} -- "
+        " --target TARGET --tool {perf,callgrind} [--roi] -- "
         "<target executable> [<target executable options>]")
 
     parser.add_argument("-s", "--start", dest="start", type=str, required=True,
@@ -281,6 +355,9 @@ def main():
                         help="QEMU target")
     parser.add_argument("--tool", dest="tool", choices=["perf", "callgrind"],
                         required=True, help="Tool used for measurements")
+    parser.add_argument("--roi", dest="roi", action="store_true",
+                        help="Measure only the region of interest of the "
+                        "benchmark")
 
     parser.add_argument("command", type=str, nargs="+", help=argparse.SUPPRESS)
 
@@ -293,6 +370,7 @@ def main():
     target = args.target
     tool = args.tool
     command = args.command
+    roi = args.roi
 
     # Set QEMU path
     if qemu == "":
@@ -332,7 +410,8 @@ def main():
     start_commit_instructions = measure_instructions(tool,
                                                      qemu_build_path,
                                                      target,
-                                                     command)
+                                                     command,
+                                                     roi)
     print("{:<30} {}".format("Start Commit Instructions:",
                              format(start_commit_instructions, ",")))
 
@@ -342,7 +421,8 @@ def main():
     end_commit_instructions = measure_instructions(tool,
                                                    qemu_build_path,
                                                    target,
-                                                   command)
+                                                   command,
+                                                   roi)
     print("{:<30} {}".format("End Commit Instructions:",
                              format(end_commit_instructions, ",")))
 
@@ -383,7 +463,8 @@ def main():
         instructions = measure_instructions(tool,
                                             qemu_build_path,
                                             target,
-                                            command)
+                                            command,
+                                            roi)
         # Find the difference between the current instructions and start/end
         # instructions.
         diff_end = abs(instructions - end_commit_instructions)
@@ -0,0 +1,298 @@
+#!/usr/bin/env python3
+
+"""
+Calibrate the problem size of each benchmark for each target, so that the
+benchmarks of a problem size preset run for about the same time (or execute
+about the same number of instructions) on all targets.
+
+This file is a part of the project "TCG Continuous Benchmarking".
+
+Copyright (C) 2020  Ahmed Karaman <ahmedkhaledkaraman@gmail.com>
+Copyright (C) 2020  Aleksandar Markovic <aleksandar.qemu.devel@gmail.com>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/>.
+"""
+
+import argparse
+import csv
+import datetime
+import math
+import os
+import pathlib
+import subprocess
+import sys
+import tempfile
+from typing import Dict, List, Optional, Tuple
+
+import nightly_tests_core as core
+
+
+# Budget of each preset, in seconds of execution time under QEMU or in
+# instructions executed by QEMU in the region of interest
+BUDGETS = {
+    "time": {"small": 0.5, "medium": 2.0, "large": 8.0},
+    "instructions": {"small": 2e9, "medium": 1e10, "large": 5e10}
+}
+
+# The problem size starts at START_SIZE and grows by GROWTH_FACTOR until the
+# largest budget is reached
+START_SIZE = 4
+GROWTH_FACTOR = 2
+
+
+def measure_cost(metric: str, qemu_exe_path: str, executable_path: str,
+                 benchmark_name: str, size: int) -> Optional[float]:
+    """
+    Run a benchmark with a problem size under QEMU and measure its cost.
+
+    Parameters:
+    metric (str): Measured cost (time|instructions)
+    qemu_exe_path (str): Absolute path to the QEMU executable
+    executable_path (str): Absolute path to the driver executable
+    benchmark_name (str): Benchmark name
+    size (int): Problem size passed with '-n'
+
+    Returns:
+    (Optional[float]): Execution time in seconds or number of instructions,
+                       None if the benchmark rejected the problem size
+    """
+    if metric == "time":
+        run_benchmark = subprocess.run(core.get_qemu_command(
+                                           qemu_exe_path, benchmark_name)
+                                       + [executable_path,
+                                          "-t",
+                                          benchmark_name,
+                                          "-n",
+                                          str(size)],
+                                       stdout=subprocess.DEVNULL,
+                                       stderr=subprocess.PIPE,
+                                       check=False)
+        if run_benchmark.returncode:
+            return None
+        for line in run_benchmark.stderr.decode("utf-8").split("\n"):
+            if line.startswith("TIME:"):
+                return float(line.split(" ")[2])
+        return None
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        run_callgrind = subprocess.run(["valgrind",
+                                        "--tool=callgrind",
+                                        "--callgrind-out-file={}".format(
+                                            os.path.join(
+                                                tmpdir, "callgrind.out")),
+                                        "--zero-before={}".format(
+                                            core.ROI_BEGIN_FUNCTION),
+                                        "--dump-before={}".format(
+                                            core.ROI_END_FUNCTION)]
+                                       + core.get_qemu_command(
+                                           qemu_exe_path, benchmark_name)
+                                       + core.get_benchmark_command(
+                                           executable_path,
+                                           benchmark_name,
+                                           size),
+                                       stdout=subprocess.DEVNULL,
+                                       stderr=subprocess.PIPE,
+                                       check=False)
+        if run_callgrind.returncode:
+            return None
+        return core.get_callgrind_instructions(
+            tmpdir, run_callgrind.stderr.decode("utf-8"))
+
+
+def interpolate_size(measurements: List[Tuple[int, float]],
+                     budget: float) -> int:
+    """
+    Estimate the problem size whose cost matches the budget. The cost is
+    assumed to grow as a power of the problem size between the two measured
+    sizes around the budget.
+
+    Parameters:
+    measurements (List[Tuple[int, float]]): (size, cost) sorted by size
+    budget (float): Target cost
+
+    Returns:
+    (int): Problem size
+    """
+    below = [m for m in measurements if m[1] < budget]
+    above = [m for m in measurements if m[1] >= budget]
+
+    # The budget is out of the measured range
+    if not above:
+        return measurements[-1][0]
+    if not below:
+        return above[0][0]
+
+    (size_below, cost_below), (size_above, cost_above) = below[-1], above[0]
+    if cost_below <= 0 or cost_above <= cost_below:
+        return size_above
+    exponent = math.log(size_above / size_below) / \
+        math.log(cost_above / cost_below)
+    size = round(size_below * (budget / cost_below) ** exponent)
+
+    return max(size_below, min(size_above, size))
+
+
+def calibrate_benchmark(metric: str, budgets: Dict[str, float],
+                        qemu_exe_path: str, executable_path: str,
+                        benchmark_name: str) -> Dict[str, int]:
+    """
+    Grow the problem size of a benchmark geometrically until the largest
+    budget is reached, then find the problem size of each preset.
+
+    Parameters:
+    metric (str): Measured cost (time|instructions)
+    budgets (Dict[str, float]): Budget of each preset
+    qemu_exe_path (str): Absolute path to the QEMU executable
+    executable_path (str): Absolute path to the driver executable
+    benchmark_name (str): Benchmark name
+
+    Returns:
+    (Dict[str, int]): Problem size of each preset
+    """
+    measurements: List[Tuple[int, float]] = []
+    size = START_SIZE
+    while True:
+        cost = measure_cost(metric, qemu_exe_path, executable_path,
+                            benchmark_name, size)
+        # Stop at the largest problem size accepted by the benchmark
+        if cost is None:
+            break
+        measurements.append((size, cost))
+        if cost >= max(budgets.values()):
+            break
+        size *= GROWTH_FACTOR
+
+    if not measurements:
+        sys.exit("Calibration of {} failed".format(benchmark_name))
+
+    return {preset: interpolate_size(measurements, budget)
+            for preset, budget in budgets.items()}
+
+
+def write_size_table(size_table_path: str,
+                     sizes: Dict[Tuple[str, str, str], int]) -> None:
+    """
+    Write the problem sizes to the size table.
+
+    Parameters:
+    size_table_path (str): Absolute path to the size table
+    sizes (Dict[Tuple[str, str, str], int]):
+                            {(preset, target_name, benchmark_name): size}
+    """
+    with open(size_table_path, "w", newline="") as size_table:
+        writer = csv.writer(size_table)
+        writer.writerow(["preset", "target", "benchmark", "size"])
+        for (preset, target, benchmark), size in sorted(
+                sizes.items(),
+                key=lambda item: (core.PRESETS.index(item[0][0]),
+                                  item[0][1], item[0][2])):
+            writer.writerow([preset, target, benchmark, size])
+
+
+def main():
+    """
+    Parse the command line arguments then start the calibration.
+
+    Syntax:
+        calibrate_sizes.py [-h] -q QEMU_BUILD [-m {time,instructions}] \
+        [-t TARGET [TARGET ...]] [-p PRESET [PRESET ...]]
+    Arguments:
+        -h, --help            Show this help message and exit
+        -q QEMU_BUILD, --qemu QEMU_BUILD
+                            Path to a QEMU build directory with the
+                            linux-user targets
+        -m {time,instructions}, --metric {time,instructions}
+                            Calibrate for execution time or for instructions
+                            (measured with callgrind) - Default is time
+        -t TARGET [TARGET ...], --targets TARGET [TARGET ...]
+                            Targets to calibrate - Default is all targets
+        -p PRESET [PRESET ...], --presets PRESET [PRESET ...]
+                            Presets to calibrate - Default is all presets
+    Example of usage:
+        calibrate_sizes.py -q /path/to/qemu/build -t aarch64 ppc
+    """
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-q", "--qemu", dest="qemu_build", required=True,
+                        help="Path to a QEMU build directory with the "
+                        "linux-user targets")
+    parser.add_argument("-m", "--metric", dest="metric",
+                        choices=BUDGETS.keys(), default="time",
+                        help="Calibrate for execution time or for "
+                        "instructions - Default is time")
+    parser.add_argument("-t", "--targets", dest="targets", nargs="+",
+                        choices=core.TARGETS.keys(),
+                        default=list(core.TARGETS.keys()),
+                        help="Targets to calibrate - Default is all targets")
+    parser.add_argument("-p", "--presets", dest="presets", nargs="+",
+                        choices=core.PRESETS, default=core.PRESETS,
+                        help="Presets to calibrate - Default is all presets")
+    args = parser.parse_args()
+
+    budgets = {preset: BUDGETS[args.metric][preset]
+               for preset in args.presets}
+    targets = {target: core.TARGETS[target] for target in args.targets}
+
+    # Get required paths
+    nightly_tests_dir_path = pathlib.Path(__file__).parent.parent.absolute()
+    benchmarks_dir_path = os.path.join(nightly_tests_dir_path, "benchmarks")
+    benchmarks_source_dir_path = os.path.join(benchmarks_dir_path, "source")
+    benchmarks_executables_dir_path = os.path.join(
+        benchmarks_dir_path, "executables")
+    size_table_path = os.path.join(nightly_tests_dir_path,
+                                   core.SIZE_TABLE_FILE)
+
+    if not os.path.isdir(benchmarks_executables_dir_path):
+        os.mkdir(benchmarks_executables_dir_path)
+
+    benchmark_paths = core.get_benchmark_paths(benchmarks_source_dir_path)
+    core.verify_executables(benchmark_paths, targets,
+                            benchmarks_source_dir_path,
+                            benchmarks_executables_dir_path)
+
+    # Keep the sizes of the presets and targets that are not calibrated
+    sizes: Dict[Tuple[str, str, str], int] = {}
+    if os.path.isfile(size_table_path):
+        for preset in core.PRESETS:
+            for benchmark, target_sizes in core.read_size_table(
+                    size_table_path, preset).items():
+                for target, size in target_sizes.items():
+                    sizes[(preset, target, benchmark)] = size
+
+    for target in targets:
+        qemu_exe_path = os.path.join(os.path.abspath(args.qemu_build),
+                                     "{}-linux-user".format(target),
+                                     "qemu-{}".format(target))
+        executable_path = core.get_driver_executable_path(
+            benchmarks_executables_dir_path, target)
+
+        for benchmark_path in benchmark_paths:
+            benchmark_name = core.get_benchmark_name(benchmark_path)
+            print(datetime.datetime.utcnow().isoformat(),
+                  "- Calibrating {} for {}".format(benchmark_name, target),
+                  file=sys.stderr, flush=True)
+            preset_sizes = calibrate_benchmark(args.metric, budgets,
+                                               qemu_exe_path, executable_path,
+                                               benchmark_name)
+            for preset, size in preset_sizes.items():
+                sizes[(preset, target, benchmark_name)] = size
+                print("{:<10} {:<10} {:<25} {}".format(
+                    preset, target, benchmark_name, size))
+
+        # Save the table after each target, so a long calibration can be
+        # continued target by target
+        write_size_table(size_table_path, sizes)
+
+
+if __name__ == "__main__":
+    main()
@@ -34,7 +34,65 @@ import subprocess
 import sys
 import tempfile
 import time
-from typing import Dict, List, Optional, Union
+from typing import Dict, List, Optional, Tuple, Union
+
+# Host libc functions called by QEMU when a benchmark enters and leaves its
+# region of interest (see benchmarks/common/roi.h)
+ROI_BEGIN_FUNCTION = "*getpgid"
+ROI_END_FUNCTION = "*getsid"
+
+# Cross compiler of each QEMU target
+TARGETS = {
+    "aarch64":  "aarch64-linux-gnu-gcc",
+    "alpha":    "alpha-linux-gnu-gcc",
+    "arm":      "arm-linux-gnueabi-gcc",
+    "hppa":     "hppa-linux-gnu-gcc",
+    "m68k":     "m68k-linux-gnu-gcc",
+    "mips":     "mips-linux-gnu-gcc",
+    "mipsel":   "mipsel-linux-gnu-gcc",
+    "mips64":   "mips64-linux-gnuabi64-gcc",
+    "mips64el": "mips64el-linux-gnuabi64-gcc",
+    "ppc":      "powerpc-linux-gnu-gcc",
+    "ppc64":    "powerpc64-linux-gnu-gcc",
+    "ppc64le":  "powerpc64le-linux-gnu-gcc",
+    "riscv64":  "riscv64-linux-gnu-gcc",
+    "s390x":    "s390x-linux-gnu-gcc",
+    "sh4":      "sh4-linux-gnu-gcc",
+    "sparc64":  "sparc64-linux-gnu-gcc",
+    "x86_64":   "gcc"
+}
+
+# Problem size presets, and the file of the calibrated problem size of each
+# benchmark for each preset and target (see calibrate_sizes.py)
+PRESETS = ["small", "medium", "large"]
+SIZE_TABLE_FILE = "sizes.csv"
+
+# Directory of the multi-call driver that all benchmarks are linked into
+# (see benchmarks/tcgbench/tcgbench.c)
+DRIVER_DIR = "tcgbench"
+
+# Prefix of the benchmarks that measure the scaling of MTTCG with the number
+# of guest threads (see benchmarks/threads). Callgrind serializes all threads
+# of QEMU, and their instruction counts depend on the scheduling, so they are
+# left out of the instruction counts. Instead, their scaling reports (time
+# and speedup for each number of threads) are measured by running QEMU
+# directly, and compared with the latest results.
+SCALING_BENCHMARK_PREFIX = "threads_"
+
+# QEMU options of some benchmarks. The translated code of codesize is a few
+# MB, which fits in the default translation buffer of QEMU, so it is run with
+# the smallest buffer (1 MB) to make QEMU flush the buffer and translate the
+# code again over and over.
+BENCHMARK_QEMU_OPTIONS = {
+    "codesize": ["-tb-size", "1"]
+}
+
+# Extra compiler flags of some benchmarks. These benchmarks are compiled to
+# separate objects first, so the flags do not apply to the other benchmarks
+# (-ffast-math would also link crtfastmath.o into the whole driver).
+BENCHMARK_FLAGS = {
+    "coulomb_double_fastmath": ["-ffast-math"]
+}
 
 
 def get_benchmark_name(benchmark_path: str) -> str:
@@ -67,26 +125,57 @@ def get_benchmark_parent_dir(benchmark_path: str) -> str:
     return benchmark_parent_dir
 
 
-def get_executable_parent_dir_path(
-        benchmark_path: str, benchmarks_executables_dir_path: str) -> str:
+def is_scaling_benchmark(benchmark_path: str) -> bool:
     """
-    Return the executables parent directory of a benchmark given its path.
-    This is the directory that includes all compiled executables for the
-    benchmark.
+    Return whether a benchmark measures the scaling with the number of
+    threads instead of being counted with callgrind.
 
     Parameters:
     benchmarks_path (str): Absolute path to benchmark
-    benchmarks_executables_dir_path (str): Absolute path to the executables
 
     Return:
-    (str): Executables parent directory path
+    (bool): True for a scaling benchmark
     """
-    benchmark_parent_dir_path = os.path.split(benchmark_path)[0]
-    benchmark_parent_dir = os.path.split(benchmark_parent_dir_path)[1]
-    executable_parent_dir_path = os.path.join(benchmarks_executables_dir_path,
-                                              benchmark_parent_dir)
+    return get_benchmark_name(benchmark_path).startswith(
+        SCALING_BENCHMARK_PREFIX)
+
+
+def get_benchmark_paths(benchmarks_source_dir_path: str) -> List[str]:
+    """
+    Return the absolute paths to all available benchmarks, except the
+    multi-call driver.
+
+    Parameters:
+    benchmarks_source_dir_path (str): Absolute path to the benchmarks sources
+
+    Return:
+    (List[str]): Sorted list of the benchmark paths
+    """
+    return sorted([y for x in os.walk(benchmarks_source_dir_path)
+                   for y in glob.glob(os.path.join(x[0], '*.c'))
+                   if get_benchmark_parent_dir(y) != DRIVER_DIR])
+
+
+def read_size_table(size_table_path: str,
+                    preset: str) -> Dict[str, Dict[str, int]]:
+    """
+    Read the calibrated problem sizes of a preset from the size table.
+
+    Parameters:
+    size_table_path (str): Absolute path to the size table
+    preset (str): Problem size preset
 
-    return executable_parent_dir_path
+    Return:
+    (Dict[str, Dict[str, int]]): {benchmark_name: {target_name: size}}
+    """
+    sizes: Dict[str, Dict[str, int]] = {}
+    with open(size_table_path, "r", newline="") as size_table:
+        for row in csv.DictReader(size_table):
+            if row["preset"] == preset:
+                sizes.setdefault(row["benchmark"], {})[row["target"]] = \
+                    int(row["size"])
+
+    return sizes
 
 
 def get_commit_hash(commit_tag: str, qemu_path: str) -> str:
@@ -257,32 +346,162 @@ def build_qemu(qemu_path: str, git_tag: str, targets: List[str]) -> None:
         clean_exit(qemu_path, make.stderr.decode("utf-8"))
 
 
-def compile_target(benchmark_path: str, compiled_benchmark_path: str,
+def get_driver_executable_path(benchmarks_executables_dir_path: str,
+                               target: str) -> str:
+    """
+    Return the path to the multi-call driver executable of a target.
+
+    Parameters:
+    benchmarks_executables_dir_path (str): Absolute path to the executables
+    target (str): QEMU target
+
+    Return:
+    (str): Driver executable path
+    """
+    return os.path.join(benchmarks_executables_dir_path,
+                        "{}-{}".format(DRIVER_DIR, target))
+
+
+def compile_target(benchmark_paths: List[str], driver_path: str,
+                   compiled_benchmark_path: str,
                    target_compiler: str) -> None:
     """
-    Compile a benchmark using the provided cross compiler.
+    Compile the multi-call driver together with all benchmarks using the
+    provided cross compiler. The benchmarks with extra compiler flags (see
+    BENCHMARK_FLAGS) are compiled to separate objects first.
 
     Parameters:
-    benchmarks_path (str): Absolute path to benchmark
+    benchmark_paths (List[str]): List of all paths to benchmarks
+    driver_path (str): Absolute path to the driver source
     compiled_benchmark_path (str): Path to the output executable
     target_compiler (str): Cross compiler
     """
-    compile_benchmark = subprocess.run([target_compiler,
-                                        "-O2",
-                                        "-static",
-                                        "-w",
-                                        benchmark_path,
-                                        "-o",
-                                        compiled_benchmark_path],
-                                       check=False)
+    with tempfile.TemporaryDirectory() as tmpdir:
+        sources = []
+        for benchmark_path in benchmark_paths:
+            benchmark_name = get_benchmark_name(benchmark_path)
+            if benchmark_name not in BENCHMARK_FLAGS:
+                sources.append(benchmark_path)
+                continue
+            object_path = os.path.join(tmpdir, benchmark_name + ".o")
+            compile_object = subprocess.run([target_compiler,
+                                             "-O2",
+                                             "-w",
+                                             "-DTCGBENCH"]
+                                            + BENCHMARK_FLAGS[benchmark_name]
+                                            + ["-c",
+                                               benchmark_path,
+                                               "-o",
+                                               object_path],
+                                            check=False)
+            if compile_object.returncode:
+                sys.exit("Compilation of {} failed".format(benchmark_name))
+            sources.append(object_path)
+
+        compile_benchmark = subprocess.run([target_compiler,
+                                            "-O2",
+                                            "-static",
+                                            "-w",
+                                            "-DTCGBENCH",
+                                            driver_path]
+                                           + sources
+                                           + ["-o",
+                                              compiled_benchmark_path,
+                                              "-lm",
+                                              "-pthread"],
+                                           check=False)
     if compile_benchmark.returncode:
         sys.exit("Compilation of {} failed".format(
             os.path.split(compiled_benchmark_path)[1]))
 
 
+def get_callgrind_instructions(callgrind_out_dir_path: str,
+                               callgrind_stderr: str) -> int:
+    """
+    Get the number of instructions of the region of interest from the output
+    files of callgrind. A benchmark may enter the region of interest several
+    times (for example once for each kernel), and callgrind writes one file
+    at each exit, so the instructions of all these files are added up. If the
+    region of interest was not reached, the total number of instructions
+    printed by callgrind is returned instead.
+
+    Parameters:
+    callgrind_out_dir_path (str): Absolute path to the callgrind output files
+    callgrind_stderr (str): Standard error output of callgrind
+
+    Returns:
+    (int): Number of instructions
+    """
+    roi_instructions = 0
+    roi_reached = False
+    for out_file_path in sorted(
+            glob.glob(os.path.join(callgrind_out_dir_path, "*"))):
+        with open(out_file_path, "r") as out_file:
+            roi_dump = False
+            for line in out_file:
+                if line.startswith("desc: Trigger: --dump-before"):
+                    roi_dump = True
+                elif roi_dump and line.startswith(("summary:", "totals:")):
+                    roi_instructions += int(line.split()[1])
+                    roi_reached = True
+                    break
+
+    if roi_reached:
+        return roi_instructions
+    return int(callgrind_stderr.split("\n")[8].split(" ")[-1])
+
+
+def get_benchmark_command(executable_path: str, benchmark_name: str,
+                          size: Optional[int] = None) -> List[str]:
+    """
+    Return the command running a benchmark with the multi-call driver.
+
+    Parameters:
+    executable_path (str): Absolute path to the driver executable
+    benchmark_name (str): Benchmark name
+    size (Optional[int]): Problem size passed with '-n', if any
+
+    Return:
+    (List[str]): Program path and arguments
+    """
+    command = [executable_path, benchmark_name]
+    if size is not None:
+        command += ["-n", str(size)]
+
+    return command
+
+
+def get_qemu_command(qemu_exe_path: str, benchmark_name: str) -> List[str]:
+    """
+    Return the QEMU executable followed by the QEMU options of a benchmark.
+    The options are left out if the QEMU version doesn't support them (its
+    help output doesn't list them), so older versions still run the
+    benchmark.
+
+    Parameters:
+    qemu_exe_path (str): Absolute path to the QEMU executable
+    benchmark_name (str): Benchmark name
+
+    Return:
+    (List[str]): QEMU path and options
+    """
+    options = BENCHMARK_QEMU_OPTIONS.get(benchmark_name, [])
+    if options:
+        qemu_help = subprocess.run([qemu_exe_path, "-h"],
+                                   stdout=subprocess.PIPE,
+                                   stderr=subprocess.DEVNULL,
+                                   check=False).stdout.decode("utf-8")
+        if not all(option in qemu_help.split()
+                   for option in options if option.startswith("-")):
+            options = []
+
+    return [qemu_exe_path] + options
+
+
 def measure_instructions(
         benchmark_path: str, benchmarks_executables_dir_path: str,
-        qemu_path: str, targets: List[str]) -> List[List[Union[str, int]]]:
+        qemu_path: str, targets: List[str],
+        sizes: Dict[str, int]) -> List[List[Union[str, int]]]:
     """
     Measure the number of instructions when running an program with QEMU.
 
@@ -291,41 +510,53 @@ def measure_instructions(
     benchmarks_executables_dir_path (str): Absolute path to the executables
     qemu_path (str): Absolute path to QEMU
     targets (List[str]): List of QEMU targets
+    sizes (Dict[str, int]): Problem size of each target, the default size of
+                            the benchmark is used for missing targets
 
     Returns:
     (List[List[Union[str, int]]]): [[target_name, instructions],[...],...]
     """
 
     benchmark_name = get_benchmark_name(benchmark_path)
-    executable_parent_dir_path = get_executable_parent_dir_path(
-        benchmark_path, benchmarks_executables_dir_path)
     qemu_build_path = os.path.join(qemu_path, "build-gcc")
 
     instructions: List[List[Union[str, int]]] = []
 
     for target in targets:
-        executable_path = os.path.join(
-            executable_parent_dir_path, "{}-{}".format(benchmark_name, target))
+        executable_path = get_driver_executable_path(
+            benchmarks_executables_dir_path, target)
 
         qemu_exe_path = os.path.join(qemu_build_path,
                                      "{}-linux-user".format(target),
                                      "qemu-{}".format(target))
 
-        with tempfile.NamedTemporaryFile() as tmpfile:
+        # Count only the region of interest of the benchmark. The counters
+        # are zeroed when the guest calls roi_begin() and dumped when it
+        # calls roi_end() (see benchmarks/common/roi.h).
+        with tempfile.TemporaryDirectory() as tmpdir:
             run_callgrind = subprocess.run(["valgrind",
                                             "--tool=callgrind",
                                             "--callgrind-out-file={}".format(
-                                                tmpfile.name),
-                                            qemu_exe_path,
-                                            executable_path],
+                                                os.path.join(
+                                                    tmpdir, "callgrind.out")),
+                                            "--zero-before={}".format(
+                                                ROI_BEGIN_FUNCTION),
+                                            "--dump-before={}".format(
+                                                ROI_END_FUNCTION)]
+                                           + get_qemu_command(qemu_exe_path,
+                                                              benchmark_name)
+                                           + get_benchmark_command(
+                                               executable_path,
+                                               benchmark_name,
+                                               sizes.get(target)),
                                            stdout=subprocess.DEVNULL,
                                            stderr=subprocess.PIPE,
                                            check=False)
-        if run_callgrind.returncode == 1:
-            clean_exit(qemu_path, run_callgrind.stderr.decode("utf-8"))
+            if run_callgrind.returncode == 1:
+                clean_exit(qemu_path, run_callgrind.stderr.decode("utf-8"))
 
-        callgrind_output = run_callgrind.stderr.decode("utf-8").split("\n")
-        instructions.append([target, int(callgrind_output[8].split(" ")[-1])])
+            instructions.append([target, get_callgrind_instructions(
+                tmpdir, run_callgrind.stderr.decode("utf-8"))])
 
     return instructions
 
@@ -334,7 +565,8 @@ def measure_master_instructions(
         reference_version_path: str, reference_commit_hash: str,
         latest_version_path: str, benchmark_path: str,
         benchmarks_executables_dir_path: str, qemu_path: str,
-        targets: List[str]) -> List[List[Union[str, int]]]:
+        targets: List[str],
+        sizes: Dict[str, int]) -> List[List[Union[str, int]]]:
     """
     Measure the latest QEMU "master" instructions and also append the latest
     instructions and reference version instructions to the instructions list.
@@ -348,6 +580,7 @@ def measure_master_instructions(
                             Absolute path to the executables of the benchmark
     qemu_path (str): Absolute path to QEMU
     targets (List[str]): List of QEMU targets
+    sizes (Dict[str, int]): Problem size of each target
 
 
     Return:
@@ -364,7 +597,8 @@ def measure_master_instructions(
           file=sys.stderr, flush=True)
 
     instructions = measure_instructions(
-        benchmark_path, benchmarks_executables_dir_path, qemu_path, targets)
+        benchmark_path, benchmarks_executables_dir_path, qemu_path, targets,
+        sizes)
 
     reference_result = "{}-{}-results.csv".format(
         reference_commit_hash, benchmark_name)
@@ -401,6 +635,172 @@ def measure_master_instructions(
     return instructions
 
 
+def parse_scaling_report(output: str) -> List[List[Union[str, int, float]]]:
+    """
+    Parse the scaling reports printed by a scaling benchmark. A benchmark
+    measuring several kernels prints a "STRUCTURE: <name>" line before the
+    report of each kernel.
+
+    Parameters:
+    output (str): Standard output of the benchmark
+
+    Returns:
+    (List[List[Union[str, int, float]]]):
+            [[kernel, threads, time, speedup],[...],...]
+            kernel is "-" for a benchmark with a single kernel
+    """
+    rows: List[List[Union[str, int, float]]] = []
+    kernel = "-"
+    in_report = False
+    for line in output.splitlines():
+        fields = line.split()
+        if line.startswith("STRUCTURE:"):
+            kernel = fields[1]
+            in_report = False
+        elif line.startswith("SCALING:"):
+            in_report = True
+        elif in_report and len(fields) == 3 and fields[0].isdigit():
+            rows.append([kernel, int(fields[0]), float(fields[1]),
+                         float(fields[2])])
+        elif not line.startswith(" "):
+            in_report = False
+
+    return rows
+
+
+def measure_scaling(benchmark_path: str, benchmarks_executables_dir_path: str,
+                    qemu_path: str, targets: List[str],
+                    sizes: Dict[str, int]) -> List[List[Union[str, int,
+                                                              float]]]:
+    """
+    Measure the scaling report of a scaling benchmark when running it with
+    QEMU. The benchmark is run directly, so the threads of the guest run in
+    parallel with MTTCG.
+
+    Parameters:
+    benchmarks_path (str): Absolute path to benchmark
+    benchmarks_executables_dir_path (str): Absolute path to the executables
+    qemu_path (str): Absolute path to QEMU
+    targets (List[str]): List of QEMU targets
+    sizes (Dict[str, int]): Problem size of each target, the default size of
+                            the benchmark is used for missing targets
+
+    Returns:
+    (List[List[Union[str, int, float]]]):
+            [[target_name, kernel, threads, time, speedup],[...],...]
+    """
+    benchmark_name = get_benchmark_name(benchmark_path)
+    qemu_build_path = os.path.join(qemu_path, "build-gcc")
+
+    print(datetime.datetime.utcnow().isoformat(),
+          "- Measuring scaling for master - {}".format(benchmark_name),
+          file=sys.stderr, flush=True)
+
+    scaling: List[List[Union[str, int, float]]] = []
+
+    for target in targets:
+        executable_path = get_driver_executable_path(
+            benchmarks_executables_dir_path, target)
+
+        qemu_exe_path = os.path.join(qemu_build_path,
+                                     "{}-linux-user".format(target),
+                                     "qemu-{}".format(target))
+
+        run_qemu = subprocess.run([qemu_exe_path]
+                                  + get_benchmark_command(
+                                      executable_path,
+                                      benchmark_name,
+                                      sizes.get(target)),
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE,
+                                  check=False)
+        if run_qemu.returncode:
+            clean_exit(qemu_path, run_qemu.stderr.decode("utf-8"))
+
+        for row in parse_scaling_report(run_qemu.stdout.decode("utf-8")):
+            scaling.append([target] + row)
+
+    return scaling
+
+
+def compare_scaling(scaling: List[List[Union[str, int, float]]],
+                    latest_result_path: str) -> None:
+    """
+    Append to each row of a scaling report the change of the speedup
+    compared to the latest results, or "N/A" if they are not available.
+
+    Parameters:
+    scaling (List[List[Union[str, int, float]]]):
+            [[target_name, kernel, threads, time, speedup],[...],...]
+    latest_result_path (str): Absolute path to the latest results, which may
+                              not exist
+    """
+    latest_speedups: Dict[Tuple[str, str, int], float] = {}
+    if os.path.isfile(latest_result_path):
+        with open(latest_result_path, "r", newline="") as file:
+            reader = csv.reader(file)
+            next(reader)
+            for row in reader:
+                latest_speedups[(row[0], row[1], int(row[2]))] = \
+                    float(row[4])
+
+    for row in scaling:
+        latest_speedup = latest_speedups.get(
+            (str(row[0]), str(row[1]), int(row[2])))
+        if latest_speedup:
+            row.append(calculate_percentage(latest_speedup, float(row[4])))
+        else:
+            row.append("N/A")
+
+
+def write_scaling_to_csv(scaling: List[List[Union[str, int, float]]],
+                         output_csv_path: str,
+                         percentages: bool = False) -> None:
+    """
+    Write the scaling report of each target in a CSV file.
+
+    Parameters:
+    scaling (List[List[Union[str, int, float]]]):
+            [[target_name, kernel, threads, time, speedup, change],[...],...]
+            change is only present after compare_scaling()
+    output_csv_path (str): Absolute path to output CSV file
+    percentages (bool): Add the change of the speedup to the output CSV file
+    """
+    with open(output_csv_path, "w", newline="") as file:
+        writer = csv.writer(file)
+        header = ["Target", "Kernel", "Threads", "Time", "Speedup"]
+        if percentages:
+            header.append("Latest")
+        writer.writerow(header)
+        for row in scaling:
+            writer.writerow(row[:6] if percentages else row[:5])
+
+
+def print_scaling_table(scaling: List[List[Union[str, int, float]]],
+                        text: str) -> None:
+    """
+    Print a scaling report in a tabular form
+
+    Parameters:
+    scaling (List[List[Union[str, int, float]]]):
+            [[target_name, kernel, threads, time, speedup, change],[...],...]
+    text (str): Text be added to the table header
+    """
+    print("{}\n{}\n{}".
+          format("-" * 64, text, "-" * 64))
+
+    print('{:<10}  {:<10}  {:>7}  {:>10}  {:>7}  {:>10}\n{}  {}  {}  {}  {}'
+          '  {}'.format('Target', 'Kernel', 'Threads', 'Time (s)',
+                        'Speedup', 'Latest', '-' * 10, '-' * 10, '-' * 7,
+                        '-' * 10, '-' * 7, '-' * 10))
+
+    for row in scaling:
+        print('{:<10}  {:<10}  {:>7}  {:>10.4f}  {:>7.3f}  {:>10}'.format(
+            *row))
+
+    print("-" * 64)
+
+
 def calculate_percentage(old_instructions: int, new_instructions: int) -> str:
     """
     Calculate the change in percentage between two instruction counts
@@ -597,16 +997,17 @@ def clean_exit(qemu_path: str, error_message: str) -> None:
 
 
 def verify_executables(benchmark_paths: List[str], targets: Dict[str, str],
-                       benchmarks: List[Dict[str, str]],
+                       benchmarks_source_dir_path: str,
                        benchmarks_executables_dir_path: str) -> None:
     """
-    Verify that all executables exist for each benchmark.
+    Verify that the multi-call driver executable of each target exists and
+    is newer than all benchmark sources, otherwise (re)compile it.
 
     Parameters:
     benchmark_paths (List[str]): List of all paths to benchmarks
     targets (Dict[str, str]): Dictionary the contains for each target,
                               target_name: target_compiler
-    benchmarks (List[Dict[str, str]]): Benchmarks data (name, parent_dir, path)
+    benchmarks_source_dir_path (str): Absolute path to the benchmarks sources
     benchmarks_executables_dir_path (str): Absolute path to the executables dir
     """
     print(datetime.datetime.utcnow().isoformat(),
@@ -614,26 +1015,25 @@ def verify_executables(benchmark_paths: List[str], targets: Dict[str, str],
           format(len(benchmark_paths), len(targets)),
           file=sys.stderr, flush=True)
 
-    for benchmark in benchmarks:
-        executable_parent_dir_path = get_executable_parent_dir_path(
-            benchmark["path"], benchmarks_executables_dir_path)
+    driver_path = os.path.join(benchmarks_source_dir_path, DRIVER_DIR,
+                               "{}.c".format(DRIVER_DIR))
 
-        # Verify that the exists for this benchmark executables, if not,
-        # create it
-        if not os.path.isdir(executable_parent_dir_path):
-            os.mkdir(executable_parent_dir_path)
-
-        for target_name, target_compiler in targets.items():
-            compiled_benchmark = "{}-{}".format(
-                benchmark["name"], target_name)
-            compiled_benchmark_path = os.path.join(
-                executable_parent_dir_path, compiled_benchmark)
-            # Verify that the the executable for this target is available,
-            # if not, compile it
-            if not os.path.isfile(compiled_benchmark_path):
-                compile_target(benchmark["path"],
-                               compiled_benchmark_path,
-                               target_compiler)
+    # Find the time of the latest change of the sources and shared headers
+    source_paths = [y for x in os.walk(benchmarks_source_dir_path)
+                    for y in glob.glob(os.path.join(x[0], '*.[ch]*'))]
+    latest_source_change = max(os.path.getmtime(source_path)
+                               for source_path in source_paths)
+
+    for target_name, target_compiler in targets.items():
+        compiled_benchmark_path = get_driver_executable_path(
+            benchmarks_executables_dir_path, target_name)
+        # Verify that the the executable for this target is available and up
+        # to date, if not, compile it
+        if not os.path.isfile(compiled_benchmark_path) or \
+                os.path.getmtime(compiled_benchmark_path) < \
+                latest_source_change:
+            compile_target(benchmark_paths, driver_path,
+                           compiled_benchmark_path, target_compiler)
 
 
 def verify_reference_results(reference_version: str, qemu_path: str,
@@ -653,7 +1053,8 @@ def verify_reference_results(reference_version: str, qemu_path: str,
     reference_version_results_dir_path (str): Absolute path to the reference
                                               version results dir
     targets (List[str]): Target names
-    benchmarks (List[Dict[str, str]]): Benchmarks data (name, parent_dir, path)
+    benchmarks (List[Dict[str, str]]): Benchmarks data (name, parent_dir, path,
+                                       sizes)
     benchmarks_executables_dir_path (str): Path to the root executables dir
     """
     print(datetime.datetime.utcnow().isoformat(),
@@ -693,7 +1094,8 @@ def verify_reference_results(reference_version: str, qemu_path: str,
                 benchmark["path"],
                 benchmarks_executables_dir_path,
                 qemu_path,
-                targets)
+                targets,
+                benchmark["sizes"])
             write_to_csv(instructions, results_path)
 
 
@@ -724,39 +1126,32 @@ def main():
     Output on STDERR must be redirected to either /dev/null or to a log file.
 
     Syntax:
-        nightly_tests_core.py [-h] [-r REF]
+        nightly_tests_core.py [-h] [-r REF] [-p {small,medium,large}]
     Optional arguments:
         -h, --help            Show this help message and exit
         -r REF, --reference REF
                             Reference QEMU version - Default is v5.1.0
+        -p {small,medium,large}, --preset {small,medium,large}
+                            Problem size preset calibrated with
+                            calibrate_sizes.py - Default is the default
+                            problem size of each benchmark
     Example of usage:
-        nightly_tests_core.py -r v5.1.0 2>log.txt
+        nightly_tests_core.py -r v5.1.0 -p medium 2>log.txt
     """
     parser = argparse.ArgumentParser()
     parser.add_argument("-r", "--reference", dest="ref",
                         default="v5.1.0",
                         help="Reference QEMU version - Default is v5.1.0")
-    reference_version = parser.parse_args().ref
-
-    targets = {
-        "aarch64":  "aarch64-linux-gnu-gcc",
-        "alpha":    "alpha-linux-gnu-gcc",
-        "arm":      "arm-linux-gnueabi-gcc",
-        "hppa":     "hppa-linux-gnu-gcc",
-        "m68k":     "m68k-linux-gnu-gcc",
-        "mips":     "mips-linux-gnu-gcc",
-        "mipsel":   "mipsel-linux-gnu-gcc",
-        "mips64":   "mips64-linux-gnuabi64-gcc",
-        "mips64el": "mips64el-linux-gnuabi64-gcc",
-        "ppc":      "powerpc-linux-gnu-gcc",
-        "ppc64":    "powerpc64-linux-gnu-gcc",
-        "ppc64le":  "powerpc64le-linux-gnu-gcc",
-        "riscv64":  "riscv64-linux-gnu-gcc",
-        "s390x":    "s390x-linux-gnu-gcc",
-        "sh4":      "sh4-linux-gnu-gcc",
-        "sparc64":  "sparc64-linux-gnu-gcc",
-        "x86_64":   "gcc"
-    }
+    parser.add_argument("-p", "--preset", dest="preset", choices=PRESETS,
+                        help="Problem size preset calibrated with "
+                        "calibrate_sizes.py - Default is the default problem "
+                        "size of each benchmark")
+    args = parser.parse_args()
+    reference_version = args.ref
+    preset = args.preset
+
+    targets = TARGETS
+
 
     # Verify that the script requirements are installed
     verify_requirements()
@@ -773,16 +1168,32 @@ def main():
         os.mkdir(benchmarks_executables_dir_path)
 
     # Get absolute path to all available benchmarks
-    benchmark_paths = sorted([y for x in os.walk(benchmarks_source_dir_path)
-                              for y in glob.glob(os.path.join(x[0], '*.c'))])
-
-    benchmarks = [{
+    benchmark_paths = get_benchmark_paths(benchmarks_source_dir_path)
+
+    # Read the problem sizes of the preset from the size table
+    sizes: Dict[str, Dict[str, int]] = {}
+    if preset is not None:
+        size_table_path = os.path.join(nightly_tests_dir_path,
+                                       SIZE_TABLE_FILE)
+        if not os.path.isfile(size_table_path):
+            sys.exit("Please run calibrate_sizes.py before using a preset.")
+        sizes = read_size_table(size_table_path, preset)
+
+    all_benchmarks = [{
         "name": get_benchmark_name(benchmark_path),
         "parent_dir": get_benchmark_parent_dir(benchmark_path),
-        "path": benchmark_path} for benchmark_path in benchmark_paths]
-
-    # Verify that all executables exist for each benchmark
-    verify_executables(benchmark_paths, targets, benchmarks,
+        "path": benchmark_path,
+        "sizes": sizes.get(get_benchmark_name(benchmark_path), {})
+    } for benchmark_path in benchmark_paths]
+
+    # The scaling benchmarks are timed instead of counted with callgrind
+    benchmarks = [benchmark for benchmark in all_benchmarks
+                  if not is_scaling_benchmark(benchmark["path"])]
+    scaling_benchmarks = [benchmark for benchmark in all_benchmarks
+                          if is_scaling_benchmark(benchmark["path"])]
+
+    # Verify that the driver executable exists for each target
+    verify_executables(benchmark_paths, targets, benchmarks_source_dir_path,
                        benchmarks_executables_dir_path)
 
     # Set QEMU path and clone from Git if the path doesn't exist
@@ -795,7 +1206,12 @@ def main():
         print("\n", file=sys.stderr, flush=True)
 
     # Verify that the results directory exists, if not, create it
+    # The results of each preset are kept apart, since the problem sizes
+    # differ
     results_dir_path = os.path.join(nightly_tests_dir_path, "results")
+    if preset is not None:
+        results_dir_path = os.path.join(nightly_tests_dir_path,
+                                        "results-{}".format(preset))
     if not os.path.isdir(results_dir_path):
         os.mkdir(results_dir_path)
 
@@ -866,7 +1282,8 @@ def main():
             benchmark["path"],
             benchmarks_executables_dir_path,
             qemu_path,
-            targets.keys())
+            targets.keys(),
+            benchmark["sizes"])
 
         # Update the "latest" directory with the new results form master
         updated_latest_version_benchmark_results = os.path.join(
@@ -890,6 +1307,45 @@ def main():
         # Store the results
         results.append([benchmark["name"], instructions])
 
+    # Measure the scaling reports of the scaling benchmarks, and compare the
+    # speedups with the "latest" results. The times depend on the load of
+    # the host, so no results are kept for the reference version.
+    scaling_results = []
+    for benchmark in scaling_benchmarks:
+        latest_version_benchmark_results_dir_path = os.path.join(
+            latest_version_results_dir_path, benchmark["parent_dir"])
+        history_benchmark_results_dir_path = os.path.join(
+            history_results_dir_path, benchmark["parent_dir"])
+        for dir_path in [latest_version_benchmark_results_dir_path,
+                         history_benchmark_results_dir_path]:
+            if not os.path.isdir(dir_path):
+                os.mkdir(dir_path)
+
+        scaling = measure_scaling(benchmark["path"],
+                                  benchmarks_executables_dir_path,
+                                  qemu_path,
+                                  targets.keys(),
+                                  benchmark["sizes"])
+
+        # Compare with the latest results, then replace them
+        latest_result_path = ""
+        for result in os.listdir(latest_version_benchmark_results_dir_path):
+            if result.endswith("-{}-scaling.csv".format(benchmark["name"])):
+                latest_result_path = os.path.join(
+                    latest_version_benchmark_results_dir_path, result)
+        compare_scaling(scaling, latest_result_path)
+        if latest_result_path != "":
+            os.unlink(latest_result_path)
+        write_scaling_to_csv(scaling, os.path.join(
+            latest_version_benchmark_results_dir_path,
+            "{}-{}-scaling.csv".format(master_commit_hash, benchmark["name"])))
+        write_scaling_to_csv(scaling, os.path.join(
+            history_benchmark_results_dir_path,
+            "{}-{}-scaling.csv".format(master_commit_hash, benchmark["name"])),
+                             True)
+
+        scaling_results.append([benchmark["name"], scaling])
+
     # Calculate the average instructions for each target
     # Only send the instructions as results without the benchmark names
     average_instructions = calculate_average(
@@ -910,6 +1366,10 @@ def main():
         print_table(instructions,
                     "Test Program: " + benchmark_name,
                     reference_version)
+    if scaling_results:
+        print("\n", " "*21, "SCALING RESULTS")
+        for [benchmark_name, scaling] in scaling_results:
+            print_scaling_table(scaling, "Test Program: " + benchmark_name)
 
     # Cleanup (delete the build directory)
     shutil.rmtree(os.path.join(qemu_path, "build-gcc"))